@@ -10,6 +10,8 @@
 #include "../data_generation/dataGenerators.h"
 
 using MABPL::Counters;
+using MABPL::MemoryArena;
+using MABPL::ArenaMark;
 using MABPL::MaxAggregation;
 using MABPL::MaxAggregation;
 using MABPL::SumAggregation;
@@ -33,8 +35,9 @@ void groupByCpuCyclesSweepBenchmark(DataSweep &dataSweep, const std::vector<Grou
                     results[k][0] = dataSweep.getRunInput();
                 }
 
-                auto inputGroupBy = new int[dataSweep.getNumElements()];
-                auto inputAggregate = new int[dataSweep.getNumElements()];
+                ArenaMark arenaMark = MemoryArena::getInstance().mark();
+                auto inputGroupBy = MemoryArena::getInstance().allocate<int>(dataSweep.getNumElements());
+                auto inputAggregate = MemoryArena::getInstance().allocate<int>(dataSweep.getNumElements());
 
                 int cardinality = dataSweep.getCardinality();
 
@@ -53,8 +56,7 @@ void groupByCpuCyclesSweepBenchmark(DataSweep &dataSweep, const std::vector<Grou
                 results[k][1 + (i * groupByImplementations.size()) + j] =
                         static_cast<double>(*Counters::getInstance().readEventSet() - cycles);
 
-                delete[] inputGroupBy;
-                delete []inputAggregate;
+                MemoryArena::getInstance().rewind(arenaMark);
 
                 std::cout << "Completed" << std::endl;
 
@@ -95,8 +97,9 @@ void groupByCpuCyclesSweepBenchmark64(DataSweep &dataSweep, const std::vector<Gr
                     results[k][0] = dataSweep.getRunInput();
                 }
 
-                auto inputGroupBy = new int64_t[dataSweep.getNumElements()];
-                auto inputAggregate = new int[dataSweep.getNumElements()];
+                ArenaMark arenaMark = MemoryArena::getInstance().mark();
+                auto inputGroupBy = MemoryArena::getInstance().allocate<int64_t>(dataSweep.getNumElements());
+                auto inputAggregate = MemoryArena::getInstance().allocate<int>(dataSweep.getNumElements());
 
                 int cardinality = dataSweep.getCardinality();
 
@@ -115,8 +118,7 @@ void groupByCpuCyclesSweepBenchmark64(DataSweep &dataSweep, const std::vector<Gr
                 results[k][1 + (i * groupByImplementations.size()) + j] =
                         static_cast<double>(*Counters::getInstance().readEventSet() - cycles);
 
-                delete[] inputGroupBy;
-                delete []inputAggregate;
+                MemoryArena::getInstance().rewind(arenaMark);
 
                 std::cout << "Completed" << std::endl;
 
@@ -156,8 +158,9 @@ void groupByBenchmarkWithExtraCounters(DataSweep &dataSweep, GroupBy groupByImpl
             results[j][0] = static_cast<long_long>(dataSweep.getRunInput());
 
             int numElements = static_cast<int>(dataSweep.getNumElements());
-            auto inputGroupBy = new int[numElements];
-            auto inputAggregate = new int[numElements];
+            ArenaMark arenaMark = MemoryArena::getInstance().mark();
+            auto inputGroupBy = MemoryArena::getInstance().allocate<int>(numElements);
+            auto inputAggregate = MemoryArena::getInstance().allocate<int>(numElements);
 
             int cardinality = static_cast<int>(dataSweep.getRunInput());
 
@@ -178,8 +181,7 @@ void groupByBenchmarkWithExtraCounters(DataSweep &dataSweep, GroupBy groupByImpl
             if (PAPI_read(benchmarkEventSet, benchmarkCounterValues) != PAPI_OK)
                 exit(1);
 
-            delete[] inputGroupBy;
-            delete[] inputAggregate;
+            MemoryArena::getInstance().rewind(arenaMark);
 
             for (int k = 0; k < static_cast<int>(benchmarkCounters.size()); ++k) {
                 results[j][1 + (i * benchmarkCounters.size()) + k] = benchmarkCounterValues[k];
@@ -319,4 +321,121 @@ void tessilRobinMapInitialisationBenchmark(const std::string &fileNamePrefix) {
     std::string fileName = fileNamePrefix + "_tsl_robinMap_initialisation_";
     std::string fullFilePath = outputFilePath + groupByCyclesFolder + fileName + ".csv";
     writeHeadersAndTableToCSV(headers, results, fullFilePath);
-}
\ No newline at end of file
+}
+
+// Mean cycles of the adaptive group by over the data set with each of the candidate values of one parameter, which is
+// left set to the fastest
+static void groupByAdaptiveCalibrationSweep(int numElements, int *inputGroupBy, int *inputAggregate, int iterations,
+                                            const std::vector<int> &candidates,
+                                            int MABPL::GroupByAdaptiveParameters::*parameter,
+                                            const std::string &parameterName) {
+    MABPL::GroupByAdaptiveParameters parameters = MABPL::getGroupByAdaptiveParameters();
+    double fastestCycles = 0;
+    int fastest = parameters.*parameter;
+    for (int candidate : candidates) {
+        parameters.*parameter = candidate;
+        MABPL::setGroupByAdaptiveParameters(parameters);
+        double candidateCycles = 0;
+        for (auto i = 0; i < iterations; ++i) {
+            long_long cycles = *Counters::getInstance().readEventSet();
+            MABPL::groupByAdaptive<MaxAggregation>(numElements, inputGroupBy, inputAggregate);
+            candidateCycles += static_cast<double>(*Counters::getInstance().readEventSet() - cycles) / iterations;
+        }
+        std::cout << parameterName << " " << candidate << ": " << candidateCycles << " cycles" << std::endl;
+        if (fastestCycles == 0 || candidateCycles < fastestCycles) {
+            fastestCycles = candidateCycles;
+            fastest = candidate;
+        }
+    }
+    parameters.*parameter = fastest;
+    MABPL::setGroupByAdaptiveParameters(parameters);
+}
+
+void groupByAdaptiveCalibrationBenchmark(DataSweep &dataSweep, int iterations, const std::string &fileNamePrefix) {
+    int numTests = dataSweep.getTotalRuns();
+    long_long cycles;
+    std::vector<std::vector<double>> results(numTests, std::vector<double>(4, 0));
+
+    std::vector<std::string> counters = {"PERF_COUNT_HW_CACHE_MISSES"};
+    long_long *cacheMisses = Counters::getInstance().getEvents(counters);
+
+    for (auto i = 0; i < iterations; ++i) {
+        for (auto k = 0; k < numTests; ++k) {
+            results[k][0] = static_cast<int>(dataSweep.getRunInput());
+
+            int numElements = dataSweep.getNumElements();
+            ArenaMark arenaMark = MemoryArena::getInstance().mark();
+            auto inputGroupBy = MemoryArena::getInstance().allocate<int>(numElements);
+            auto inputAggregate = MemoryArena::getInstance().allocate<int>(numElements);
+
+            int cardinality = dataSweep.getCardinality();
+
+            std::cout << "Calibrating for input " << static_cast<int>(dataSweep.getRunInput()) << "... ";
+
+            dataSweep.loadNextDataSetIntoMemory(inputGroupBy);
+            generateUniformDistributionInMemory(inputAggregate, numElements, 10);
+
+            cycles = *Counters::getInstance().readEventSet();
+            MABPL::groupByHash<MaxAggregation>(numElements, inputGroupBy, inputAggregate, cardinality);
+            results[k][1] += static_cast<double>(*Counters::getInstance().readEventSet() - cycles) / iterations;
+            results[k][3] += static_cast<double>(*cacheMisses) / numElements / iterations;
+
+            cycles = *Counters::getInstance().readEventSet();
+            MABPL::groupBySort<MaxAggregation>(numElements, inputGroupBy, inputAggregate);
+            results[k][2] += static_cast<double>(*Counters::getInstance().readEventSet() - cycles) / iterations;
+
+            MemoryArena::getInstance().rewind(arenaMark);
+
+            std::cout << "Completed" << std::endl;
+        }
+        dataSweep.restartSweep();
+    }
+
+    std::vector<std::string> headers = {"Input", "Hash cycles", "Sort cycles", "Hash LLC misses per tuple"};
+    std::string fileName = fileNamePrefix + "_GroupBy_AdaptiveCalibration_" + dataSweep.getSweepName();
+    std::string fullFilePath = outputFilePath + groupByCyclesFolder + fileName + ".csv";
+    writeHeadersAndTableToCSV(headers, results, fullFilePath);
+
+    int crossover = 1;
+    while (crossover < numTests && results[crossover][2] >= results[crossover][1]) {
+        ++crossover;
+    }
+    if (crossover == numTests || results[0][2] < results[0][1] || results[crossover][3] <= 0) {
+        std::cout << "No hash / sort crossover in " << dataSweep.getSweepName() << ", calibration not saved" << std::endl;
+        return;
+    }
+
+    // The adaptive group by sorts once a chunk processes fewer tuples per miss than the machine constant scaled by the
+    // number of hash table entries per cache line
+    double missesPerTuple = (results[crossover - 1][3] + results[crossover][3]) / 2;
+    MABPL::GroupByAdaptiveParameters parameters = MABPL::getGroupByAdaptiveParameters();
+    parameters.machineConstant = static_cast<float>((2 * sizeof(int)) / (missesPerTuple * MABPL::bytesPerCacheLine()));
+
+    MABPL::setGroupByAdaptiveParameters(parameters);
+
+    // Chunk sizes are swept on the data set at the crossover, where the adaptive group by switches most often
+    dataSweep.restartSweep();
+    int numElements = dataSweep.getNumElements();
+    ArenaMark arenaMark = MemoryArena::getInstance().mark();
+    auto inputGroupBy = MemoryArena::getInstance().allocate<int>(numElements);
+    auto inputAggregate = MemoryArena::getInstance().allocate<int>(numElements);
+    for (auto k = 0; k <= crossover; ++k) {
+        dataSweep.loadNextDataSetIntoMemory(inputGroupBy);
+    }
+    dataSweep.restartSweep();
+    generateUniformDistributionInMemory(inputAggregate, numElements, 10);
+
+    groupByAdaptiveCalibrationSweep(numElements, inputGroupBy, inputAggregate, iterations,
+                                    {10 * 1000, 25 * 1000, 50 * 1000, 75 * 1000, 150 * 1000, 300 * 1000},
+                                    &MABPL::GroupByAdaptiveParameters::tuplesPerChunk, "Tuples per chunk");
+    groupByAdaptiveCalibrationSweep(numElements, inputGroupBy, inputAggregate, iterations,
+                                    {500 * 1000, 1000 * 1000, 2 * 1000 * 1000, 4 * 1000 * 1000, 8 * 1000 * 1000},
+                                    &MABPL::GroupByAdaptiveParameters::tuplesBetweenHashing, "Tuples between hashing");
+    MemoryArena::getInstance().rewind(arenaMark);
+
+    parameters = MABPL::getGroupByAdaptiveParameters();
+    MABPL::saveGroupByAdaptiveParameters(MABPL::getGroupByCalibrationFilePath(), parameters);
+    std::cout << "Machine constant " << parameters.machineConstant << ", tuples per chunk " << parameters.tuplesPerChunk;
+    std::cout << " and tuples between hashing " << parameters.tuplesBetweenHashing << " saved to ";
+    std::cout << MABPL::getGroupByCalibrationFilePath() << std::endl;
+}
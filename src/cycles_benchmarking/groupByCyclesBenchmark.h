@@ -20,4 +20,10 @@ void groupByBenchmarkWithExtraCountersDuringRun(const DataFile &dataFile, std::v
 
 void tessilRobinMapInitialisationBenchmark(const std::string &fileNamePrefix);
 
+// Runs Hash and Sort over a cardinality sweep and sets the adaptive group by machine constant from the last level cache
+// misses per tuple of Hash where Sort becomes faster. The tuples per chunk and then the tuples between hashing are set
+// to the fastest of a range of values for the adaptive group by on the data set at that crossover. The results are
+// saved to the group by calibration file.
+void groupByAdaptiveCalibrationBenchmark(DataSweep &dataSweep, int iterations, const std::string &fileNamePrefix);
+
 #endif //MABPL_GROUPBYCYCLESBENCHMARK_H
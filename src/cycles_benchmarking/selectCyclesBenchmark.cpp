@@ -10,13 +10,16 @@
 #include "../data_generation/machineConfiguration.h"
 
 using MABPL::Counters;
+using MABPL::MemoryArena;
+using MABPL::ArenaMark;
 
 void selectSingleRunNoCounters(const DataFile &dataFile, Select selectImplementation, int threshold,
                                int iterations) {
     for (auto j = 0; j < iterations; ++j) {
-        auto inputData = new int[dataFile.getNumElements()];
-        auto inputFilter = new int[dataFile.getNumElements()];
-        auto selection = new int[dataFile.getNumElements()];
+        ArenaMark arenaMark = MemoryArena::getInstance().mark();
+        auto inputData = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+        auto inputFilter = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+        auto selection = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
         copyArray(LoadedData::getInstance(dataFile).getData(), inputData, dataFile.getNumElements());
         copyArray(LoadedData::getInstance(dataFile).getData(), inputFilter, dataFile.getNumElements());
 
@@ -25,9 +28,7 @@ void selectSingleRunNoCounters(const DataFile &dataFile, Select selectImplementa
         MABPL::runSelectFunction(selectImplementation,
                           dataFile.getNumElements(), inputData, inputFilter, selection, threshold);
 
-        delete[] inputData;
-        delete[] inputFilter;
-        delete[] selection;
+        MemoryArena::getInstance().rewind(arenaMark);
 
         std::cout << "Completed" << std::endl;
     }
@@ -44,9 +45,10 @@ void selectCpuCyclesSingleInputBenchmark(const DataFile &dataFile,
         results[i][0] = static_cast<long_long>(threshold);
 
         for (auto j = 0; j < numTests; ++j) {
-            auto inputData = new int[dataFile.getNumElements()];
-            auto inputFilter = new int[dataFile.getNumElements()];
-            auto selection = new int[dataFile.getNumElements()];
+            ArenaMark arenaMark = MemoryArena::getInstance().mark();
+            auto inputData = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+            auto inputFilter = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+            auto selection = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
             copyArray(LoadedData::getInstance(dataFile).getData(), inputData, dataFile.getNumElements());
             copyArray(LoadedData::getInstance(dataFile).getData(), inputFilter, dataFile.getNumElements());
 
@@ -59,9 +61,7 @@ void selectCpuCyclesSingleInputBenchmark(const DataFile &dataFile,
 
             results[i][1 + j] = *Counters::getInstance().readEventSet() - cycles;
 
-            delete[] inputData;
-            delete[] inputFilter;
-            delete[] selection;
+            MemoryArena::getInstance().rewind(arenaMark);
 
             std::cout << "Completed" << std::endl;
         }
@@ -99,9 +99,10 @@ void selectCpuCyclesMultipleInputBenchmark(const DataFile &dataFile,
             results[count][0] = static_cast<long_long>(j);
 
             for (auto k = 0; k < iterations; ++k) {
-                auto inputData = new int[dataFile.getNumElements()];
-                auto inputFilter = new int[dataFile.getNumElements()];
-                auto selection = new int[dataFile.getNumElements()];
+                ArenaMark arenaMark = MemoryArena::getInstance().mark();
+                auto inputData = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+                auto inputFilter = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+                auto selection = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
                 copyArray(LoadedData::getInstance(dataFile).getData(), inputData, dataFile.getNumElements());
                 copyArray(LoadedData::getInstance(dataFile).getData(), inputFilter, dataFile.getNumElements());
 
@@ -115,9 +116,7 @@ void selectCpuCyclesMultipleInputBenchmark(const DataFile &dataFile,
 
                 results[count][1 + (i * iterations) + k] = *Counters::getInstance().readEventSet() - cycles;
 
-                delete[] inputData;
-                delete[] inputFilter;
-                delete[] selection;
+                MemoryArena::getInstance().rewind(arenaMark);
 
                 std::cout << "Completed" << std::endl;
             }
@@ -162,9 +161,10 @@ void selectBenchmarkWithExtraCounters(const DataFile &dataFile, Select selectImp
         results[count][0] = static_cast<long_long>(thresholds[i]);
 
         for (auto j = 0; j < iterations; ++j) {
-            auto inputData = new int[dataFile.getNumElements()];
-            auto inputFilter = new int[dataFile.getNumElements()];
-            auto selection = new int[dataFile.getNumElements()];
+            ArenaMark arenaMark = MemoryArena::getInstance().mark();
+            auto inputData = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+            auto inputFilter = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+            auto selection = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
             copyArray(LoadedData::getInstance(dataFile).getData(), inputData, dataFile.getNumElements());
             copyArray(LoadedData::getInstance(dataFile).getData(), inputFilter, dataFile.getNumElements());
 
@@ -180,9 +180,7 @@ void selectBenchmarkWithExtraCounters(const DataFile &dataFile, Select selectImp
             if (PAPI_read(benchmarkEventSet, benchmarkCounterValues) != PAPI_OK)
                 exit(1);
 
-            delete[] inputData;
-            delete[] inputFilter;
-            delete[] selection;
+            MemoryArena::getInstance().rewind(arenaMark);
 
             for (int k = 0; k < static_cast<int>(benchmarkCounters.size()); ++k) {
                 results[count][1 + (j * benchmarkCounters.size()) + k] = benchmarkCounterValues[k];
@@ -224,9 +222,10 @@ void selectCpuCyclesSweepBenchmark(DataSweep &dataSweep, const std::vector<Selec
         for (auto j = 0; j < static_cast<int>(selectImplementations.size()); ++j) {
             for (auto k = 0; k < dataSweep.getTotalRuns(); ++k) {
                 results[k][0] = static_cast<double>(dataSweep.getRunInput());
-                auto inputData = new int[dataSweep.getNumElements()];
-                auto inputFilter = new int[dataSweep.getNumElements()];
-                auto selection = new int[dataSweep.getNumElements()];
+                ArenaMark arenaMark = MemoryArena::getInstance().mark();
+                auto inputData = MemoryArena::getInstance().allocate<int>(dataSweep.getNumElements());
+                auto inputFilter = MemoryArena::getInstance().allocate<int>(dataSweep.getNumElements());
+                auto selection = MemoryArena::getInstance().allocate<int>(dataSweep.getNumElements());
 
                 std::cout << "Running " << getSelectName(selectImplementations[j]) << " for input ";
                 std::cout << dataSweep.getRunInput() << "... ";
@@ -242,9 +241,7 @@ void selectCpuCyclesSweepBenchmark(DataSweep &dataSweep, const std::vector<Selec
                 results[k][1 + (i * selectImplementations.size()) + j] =
                         static_cast<double>(*Counters::getInstance().readEventSet() - cycles);
 
-                delete[] inputData;
-                delete[] inputFilter;
-                delete[] selection;
+                MemoryArena::getInstance().rewind(arenaMark);
 
                 std::cout << "Completed" << std::endl;
             }
@@ -283,9 +280,10 @@ void selectCpuCyclesInputSweepBenchmark(const DataFile &dataFile,
         for (auto j = 0; j < static_cast<int>(selectImplementations.size()); ++j) {
             for (auto k = 0; k < static_cast<int>(thresholds.size()); ++k) {
                 results[k][0] = static_cast<int>(thresholds[k]);
-                auto inputData = new int[dataFile.getNumElements()];
-                auto inputFilter = new int[dataFile.getNumElements()];
-                auto selection = new int[dataFile.getNumElements()];
+                ArenaMark arenaMark = MemoryArena::getInstance().mark();
+                auto inputData = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+                auto inputFilter = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
+                auto selection = MemoryArena::getInstance().allocate<int>(dataFile.getNumElements());
                 copyArray(LoadedData::getInstance(dataFile).getData(), inputData, dataFile.getNumElements());
                 copyArray(LoadedData::getInstance(dataFile).getData(), inputFilter, dataFile.getNumElements());
 
@@ -301,9 +299,7 @@ void selectCpuCyclesInputSweepBenchmark(const DataFile &dataFile,
                 results[k][1 + (i * selectImplementations.size()) + j] =
                         static_cast<double>(*Counters::getInstance().readEventSet() - cycles);
 
-                delete[] inputData;
-                delete[] inputFilter;
-                delete[] selection;
+                MemoryArena::getInstance().rewind(arenaMark);
 
                 std::cout << "Completed" << std::endl;
             }
@@ -3,10 +3,22 @@
 
 
 #include "operators/select.h"
+#include "operators/stringSelect.h"
 #include "operators/groupBy.h"
+#include "operators/groupByOperator.h"
+#include "operators/join.h"
+#include "operators/sort.h"
+#include "operators/topK.h"
+#include "operators/distinct.h"
+#include "operators/topGroups.h"
+#include "operators/partition.h"
+#include "operators/map.h"
 
 #include "utilities/papi.h"
 #include "utilities/systemInformation.h"
+#include "utilities/cardinalityEstimation.h"
+#include "utilities/memoryArena.h"
+#include "utilities/hugePages.h"
 
 
 #endif //MABPL_MABPL_H
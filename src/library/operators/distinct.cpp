@@ -0,0 +1,24 @@
+#include <iostream>
+
+#include "distinct.h"
+
+
+namespace MABPL {
+
+std::string getDistinctName(Distinct distinctImplementation) {
+    switch (distinctImplementation) {
+        case Distinct::DistinctHash:
+            return "Distinct_Hash";
+        case Distinct::DistinctSort:
+            return "Distinct_Sort";
+        case Distinct::DistinctAdaptive:
+            return "Distinct_Adaptive";
+        case Distinct::DistinctApproximate:
+            return "Distinct_Approximate";
+        default:
+            std::cout << "Invalid selection of 'Distinct' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
@@ -0,0 +1,57 @@
+#ifndef MABPL_DISTINCT_H
+#define MABPL_DISTINCT_H
+
+#include <string>
+#include <vector>
+
+
+namespace MABPL {
+
+enum Distinct {
+    DistinctHash,
+    DistinctSort,
+    DistinctAdaptive,
+    DistinctApproximate
+};
+
+std::string getDistinctName(Distinct distinctImplementation);
+
+// SELECT DISTINCT on an integer key column, without the aggregate column of a group by. distinctHash inserts the keys
+// into a hash set of keys and returns them in no particular order. distinctSort radix partitions the keys and marks
+// them in a cache resident bitmap per partition, returning them in key order. distinctAdaptive switches from hashing
+// to sorting as the group by adaptive does, and returns the keys in no particular order.
+template<typename T>
+std::vector<T> distinctHash(int n, const T *input);
+
+template<typename T>
+std::vector<T> distinctSort(int n, const T *input);
+
+template<typename T>
+std::vector<T> distinctAdaptive(int n, const T *input);
+
+template<typename T>
+std::vector<T> runDistinctFunction(Distinct distinctImplementation, int n, const T *input);
+
+// COUNT(DISTINCT) counts the keys the matching distinct would return without materialising them.
+// countDistinctApproximate reads the input once into a HyperLogLog sketch over 64-bit hashes, for a relative standard
+// error below 1% at any count of distinct keys an int sized input can hold.
+template<typename T>
+long countDistinctHash(int n, const T *input);
+
+template<typename T>
+long countDistinctSort(int n, const T *input);
+
+template<typename T>
+long countDistinctAdaptive(int n, const T *input);
+
+template<typename T>
+long countDistinctApproximate(int n, const T *input);
+
+template<typename T>
+long runCountDistinctFunction(Distinct distinctImplementation, int n, const T *input);
+
+}
+
+#include "distinctImplementation.h"
+
+#endif //MABPL_DISTINCT_H
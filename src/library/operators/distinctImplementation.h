@@ -0,0 +1,356 @@
+#ifndef MABPL_DISTINCTIMPLEMENTATION_H
+#define MABPL_DISTINCTIMPLEMENTATION_H
+
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include "tsl/robin_set.h"
+
+#include "groupBy.h"
+#include "../utilities/systemInformation.h"
+#include "../utilities/papi.h"
+#include "../utilities/cardinalityEstimation.h"
+#include "../utilities/memoryArena.h"
+#include "../utilities/hugePages.h"
+
+
+namespace MABPL {
+
+constexpr int DISTINCT_SKETCH_PRECISION = 14;
+constexpr int DISTINCT_SKETCH_BLOCK_SIZE = 1024;
+constexpr int DISTINCT_LEAF_BITMAP_MIN_KEYS_PER_BYTE = 8;
+
+template<typename T>
+using distinctHashSet = tsl::robin_set<T, GroupByKeyHash<T>, std::equal_to<T>, HugePageAllocator<T>>;
+
+// Counts the keys written to it, so that COUNT(DISTINCT) runs the DISTINCT code without materialising its result
+template<typename T>
+struct DistinctCountOutput {
+    long count = 0;
+    void emplace_back(T) { count++; }
+};
+
+// A key equal to the one before it is already in the set
+template<typename T>
+inline void distinctHashAux(int start, int end, const T *input, distinctHashSet<T> &set, T &smallest, T &largest) {
+    for (int i = start; i < end; i++) {
+        if (i > 0 && input[i] == input[i - 1]) {
+            continue;
+        }
+        if (set.insert(input[i]).second) {
+            smallest = std::min(smallest, input[i]);
+            largest = std::max(largest, input[i]);
+        }
+    }
+}
+
+template<typename T, typename Output>
+inline void writeDistinctSet(const distinctHashSet<T> &set, Output &result) {
+    for (auto it = set.begin(); it != set.end(); ++it) {
+        result.emplace_back(*it);
+    }
+}
+
+template<typename T, typename Output>
+void distinctHashInto(int n, const T *input, Output &result) {
+    static_assert(isGroupByKeyType<T>, "Distinct column must be an integer type");
+    distinctHashSet<T> set(std::max(static_cast<int>(2.5 * estimateCardinality(n, input)), 400000));
+    T smallest = std::numeric_limits<T>::max();
+    T largest = std::numeric_limits<T>::lowest();
+    distinctHashAux(0, n, input, set, smallest, largest);
+    writeDistinctSet(set, result);
+}
+
+// Partitions keys[start, end) on the digit of the pass into buffer and recurses with buffer as the input and other as
+// the buffer, so the caller's input is only read. The leaf pass marks the keys of a partition in a bitmap that fits L1
+// and writes the marked keys in order, unless the partition is too small to pay for scanning the bitmap and is sorted
+// instead.
+template<typename T, typename Output>
+void distinctSortAux(int start, int end, const T *keys, T *buffer, T *other, T minimum, const RadixPasses &passes,
+                     int pass, Output &result) {
+    int i;
+    int shift = passes.shift[pass];
+    int numBuckets = passes.numBuckets(pass);
+    int mask = passes.mask(pass);
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+
+    if (pass == 0 && (end - start) * DISTINCT_LEAF_BITMAP_MIN_KEYS_PER_BYTE < numBuckets) {
+        T *leafKeys = arena.allocate<T>(end - start);
+        std::copy(keys + start, keys + end, leafKeys);
+        std::sort(leafKeys, leafKeys + (end - start));
+        for (i = 0; i < end - start; i++) {
+            if (i == 0 || leafKeys[i] != leafKeys[i - 1]) {
+                result.emplace_back(leafKeys[i]);
+            }
+        }
+        arena.rewind(arenaMark);
+        return;
+    }
+
+    if (pass == 0) {
+        bool *present = arena.allocate<bool>(numBuckets);
+        std::fill(present, present + numBuckets, false);
+        for (i = start; i < end; i++) {
+            present[radixBucket(keys[i], minimum, shift, mask)] = true;
+        }
+        for (i = 0; i < numBuckets; i++) {
+            if (present[i]) {
+                result.emplace_back(radixLeafKey(keys[start], minimum, mask, i));
+            }
+        }
+        arena.rewind(arenaMark);
+        return;
+    }
+
+    int *partitions = arena.allocate<int>(numBuckets + 1);
+    partitionAux(start, end, keys, static_cast<const T *>(nullptr), buffer, static_cast<T *>(nullptr), numBuckets,
+                 [minimum, shift, mask](T key) { return radixBucket(key, minimum, shift, mask); }, partitions);
+
+    for (i = 0; i < numBuckets; i++) {
+        if (partitions[i + 1] > partitions[i]) {
+            distinctSortAux(partitions[i], partitions[i + 1], buffer, other, buffer, minimum, passes, pass - 1,
+                            result);
+        }
+    }
+    arena.rewind(arenaMark);
+}
+
+template<typename T, typename Output>
+void distinctSortKeys(int n, const T *keys, T smallest, T largest, Output &result) {
+    if (n == 0) {
+        return;
+    }
+    RadixPasses passes = radixPasses(smallest, largest, sizeof(bool));
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T *buffer = passes.count > 1 ? arena.allocate<T>(n) : nullptr;
+    T *other = passes.count > 2 ? arena.allocate<T>(n) : nullptr;
+    distinctSortAux(0, n, keys, buffer, other, smallest, passes, passes.count - 1, result);
+    arena.rewind(arenaMark);
+}
+
+template<typename T, typename Output>
+void distinctSortInto(int n, const T *input, Output &result) {
+    static_assert(isGroupByKeyType<T>, "Distinct column must be an integer type");
+    if (n == 0) {
+        return;
+    }
+    T smallest = input[0];
+    T largest = input[0];
+    keyRange(n, input, smallest, largest);
+    distinctSortKeys(n, input, smallest, largest, result);
+}
+
+template<typename T, typename Output>
+void distinctDenseAux(int n, const T *input, T smallest, T largest, Output &result) {
+    int domainSize = static_cast<int>(radixOffset(largest, smallest)) + 1;
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    bool *present = arena.allocate<bool>(domainSize);
+    std::fill(present, present + domainSize, false);
+
+    for (int i = 0; i < n; i++) {
+        present[radixOffset(input[i], smallest)] = true;
+    }
+    for (int i = 0; i < domainSize; i++) {
+        if (present[i]) {
+            result.emplace_back(denseKey(i, smallest));
+        }
+    }
+    arena.rewind(arenaMark);
+}
+
+// The keys of the hash set and of the sections left unhashed are gathered and sorted together, the leaf pass
+// removing the keys that are in both
+template<typename T, typename Output>
+void distinctAdaptiveAuxSort(const T *input, const vectorOfPairs<int, int> &sectionsToBeSorted,
+                             const distinctHashSet<T> &set, T smallest, T largest, Output &result) {
+    long elements = static_cast<long>(set.size());
+    for (const auto &section : sectionsToBeSorted) {
+        keyRange(section.second - section.first, input + section.first, smallest, largest);
+        elements += section.second - section.first;
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T *keys = arena.allocate<T>(elements);
+    long index = 0;
+    for (auto it = set.begin(); it != set.end(); ++it) {
+        keys[index++] = *it;
+    }
+    for (const auto &section : sectionsToBeSorted) {
+        std::copy(input + section.first, input + section.second, keys + index);
+        index += section.second - section.first;
+    }
+    distinctSortKeys(static_cast<int>(elements), keys, smallest, largest, result);
+    arena.rewind(arenaMark);
+}
+
+// Follows groupByAdaptiveInto with the same parameters: a dense key domain is marked in a bitmap, and otherwise chunks
+// are hashed while last level cache misses per tuple stay below the threshold for a key-only set, and the next section
+// is left to be sorted when they do not
+template<typename T, typename Output>
+void distinctAdaptiveInto(int n, const T *input, Output &result) {
+    static_assert(isGroupByKeyType<T>, "Distinct column must be an integer type");
+    if (n == 0) {
+        return;
+    }
+
+    const GroupByAdaptiveParameters &parameters = getGroupByAdaptiveParameters();
+    int tuplesPerChunk = parameters.tuplesPerChunk;
+    int tuplesBetweenHashing = parameters.tuplesBetweenHashing;
+
+    T smallest = input[0];
+    T largest = input[0];
+    keyRange(std::min(tuplesPerChunk, n), input, smallest, largest);
+    if (denseKeyDomain(n, smallest, largest)) {
+        keyRange(n, input, smallest, largest);
+        if (denseKeyDomain(n, smallest, largest)) {
+            distinctDenseAux(n, input, smallest, largest, result);
+            return;
+        }
+    }
+
+    int cardinality = estimateCardinality(n, input);
+    int hashTableEntryBytes = sizeof(T);
+    float tuplesPerLastLevelCacheMissThreshold =
+            (parameters.machineConstant * bytesPerCacheLine()) / hashTableEntryBytes;
+
+    vectorOfPairs<int, int> sectionsToBeSorted;
+    int index = 0;
+    int tuplesToProcess;
+    if (groupBySortFromStart(cardinality, hashTableEntryBytes)) {
+        tuplesToProcess = std::min(tuplesBetweenHashing, n);
+        sectionsToBeSorted.emplace_back(0, tuplesToProcess);
+        index += tuplesToProcess;
+    }
+
+    distinctHashSet<T> set(std::max(static_cast<int>(2.5 * cardinality), 400000));
+    T setSmallest = std::numeric_limits<T>::max();
+    T setLargest = std::numeric_limits<T>::lowest();
+
+    std::vector<std::string> counters = {"PERF_COUNT_HW_CACHE_MISSES"};
+    long_long *counterValues = Counters::getInstance().getEvents(counters);
+
+    while (index < n) {
+        tuplesToProcess = std::min(tuplesPerChunk, n - index);
+
+        Counters::getInstance().readEventSet();
+        distinctHashAux(index, index + tuplesToProcess, input, set, setSmallest, setLargest);
+        Counters::getInstance().readEventSet();
+        index += tuplesToProcess;
+
+        if ((static_cast<float>(tuplesToProcess) / counterValues[0]) < tuplesPerLastLevelCacheMissThreshold) {
+            tuplesToProcess = std::min(tuplesBetweenHashing, n - index);
+            sectionsToBeSorted.emplace_back(index, index + tuplesToProcess);
+            index += tuplesToProcess;
+        }
+    }
+
+    if (sectionsToBeSorted.empty()) {
+        writeDistinctSet(set, result);
+        return;
+    }
+    distinctAdaptiveAuxSort(input, sectionsToBeSorted, set, setSmallest, setLargest, result);
+}
+
+template<typename T, typename Output>
+void runDistinctFunctionInto(Distinct distinctImplementation, int n, const T *input, Output &result) {
+    switch (distinctImplementation) {
+        case Distinct::DistinctHash:
+            distinctHashInto(n, input, result);
+            return;
+        case Distinct::DistinctSort:
+            distinctSortInto(n, input, result);
+            return;
+        case Distinct::DistinctAdaptive:
+            distinctAdaptiveInto(n, input, result);
+            return;
+        default:
+            std::cout << "Invalid selection of 'Distinct' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+template<typename T>
+std::vector<T> distinctHash(int n, const T *input) {
+    std::vector<T> result;
+    distinctHashInto(n, input, result);
+    return result;
+}
+
+template<typename T>
+std::vector<T> distinctSort(int n, const T *input) {
+    std::vector<T> result;
+    distinctSortInto(n, input, result);
+    return result;
+}
+
+template<typename T>
+std::vector<T> distinctAdaptive(int n, const T *input) {
+    std::vector<T> result;
+    distinctAdaptiveInto(n, input, result);
+    return result;
+}
+
+template<typename T>
+std::vector<T> runDistinctFunction(Distinct distinctImplementation, int n, const T *input) {
+    std::vector<T> result;
+    runDistinctFunctionInto(distinctImplementation, n, input, result);
+    return result;
+}
+
+template<typename T>
+long countDistinctHash(int n, const T *input) {
+    DistinctCountOutput<T> result;
+    distinctHashInto(n, input, result);
+    return result.count;
+}
+
+template<typename T>
+long countDistinctSort(int n, const T *input) {
+    DistinctCountOutput<T> result;
+    distinctSortInto(n, input, result);
+    return result.count;
+}
+
+template<typename T>
+long countDistinctAdaptive(int n, const T *input) {
+    DistinctCountOutput<T> result;
+    distinctAdaptiveInto(n, input, result);
+    return result.count;
+}
+
+template<typename T>
+long countDistinctApproximate(int n, const T *input) {
+    uint64_t keys[DISTINCT_SKETCH_BLOCK_SIZE];
+    uint64_t hashes[DISTINCT_SKETCH_BLOCK_SIZE];
+    HyperLogLog sketch(DISTINCT_SKETCH_PRECISION);
+    for (int start = 0; start < n; start += DISTINCT_SKETCH_BLOCK_SIZE) {
+        int blockSize = std::min(DISTINCT_SKETCH_BLOCK_SIZE, n - start);
+        for (int i = 0; i < blockSize; i++) {
+            keys[i] = foldKey64(input[start + i]);
+        }
+        hashKeys(blockSize, keys, hashes);
+        sketch.addHashes(blockSize, hashes);
+    }
+    return std::lround(sketch.estimate());
+}
+
+template<typename T>
+long runCountDistinctFunction(Distinct distinctImplementation, int n, const T *input) {
+    if (distinctImplementation == Distinct::DistinctApproximate) {
+        return countDistinctApproximate(n, input);
+    }
+    DistinctCountOutput<T> result;
+    runDistinctFunctionInto(distinctImplementation, n, input, result);
+    return result.count;
+}
+
+}
+
+#endif //MABPL_DISTINCTIMPLEMENTATION_H
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <fstream>
+#include <cstdlib>
 
 #include "groupBy.h"
 
@@ -11,6 +13,10 @@ std::string getGroupByName(GroupBy groupByImplementation) {
             return "GroupBy_Hash";
         case GroupBy::Sort:
             return "GroupBy_Sort";
+        case GroupBy::Dense:
+            return "GroupBy_Dense";
+        case GroupBy::Hybrid:
+            return "GroupBy_Hybrid";
         case GroupBy::Adaptive:
             return "GroupBy_Adaptive";
         default:
@@ -19,4 +25,67 @@ std::string getGroupByName(GroupBy groupByImplementation) {
     }
 }
 
+static GroupByAdaptiveParameters &groupByAdaptiveParameters() {
+    static GroupByAdaptiveParameters parameters = [] {
+        GroupByAdaptiveParameters defaults = {GROUPBY_MACHINE_CONSTANT, GROUPBY_TUPLES_PER_CHUNK,
+                                              GROUPBY_TUPLES_BETWEEN_HASHING};
+        loadGroupByAdaptiveParameters(getGroupByCalibrationFilePath(), defaults);
+        return defaults;
+    }();
+    return parameters;
+}
+
+const GroupByAdaptiveParameters &getGroupByAdaptiveParameters() {
+    return groupByAdaptiveParameters();
+}
+
+void setGroupByAdaptiveParameters(const GroupByAdaptiveParameters &parameters) {
+    groupByAdaptiveParameters() = parameters;
+}
+
+std::string getGroupByCalibrationFilePath() {
+    const char *filePath = std::getenv("MABPL_GROUPBY_CALIBRATION_FILE");
+    return filePath != nullptr ? filePath : "groupByCalibration.txt";
+}
+
+// The file holds one 'name value' pair per line. Missing names keep their current value and a missing file changes
+// nothing.
+bool loadGroupByAdaptiveParameters(const std::string &filePath, GroupByAdaptiveParameters &parameters) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string name;
+    while (file >> name) {
+        if (name == "machineConstant") {
+            file >> parameters.machineConstant;
+        } else if (name == "tuplesPerChunk") {
+            file >> parameters.tuplesPerChunk;
+        } else if (name == "tuplesBetweenHashing") {
+            file >> parameters.tuplesBetweenHashing;
+        } else {
+            std::getline(file, name);
+        }
+    }
+
+    if (!(parameters.machineConstant > 0) || parameters.tuplesPerChunk <= 0 || parameters.tuplesBetweenHashing <= 0) {
+        std::cout << "Invalid group by calibration in '" << filePath << "'!" << std::endl;
+        exit(1);
+    }
+    return true;
+}
+
+void saveGroupByAdaptiveParameters(const std::string &filePath, const GroupByAdaptiveParameters &parameters) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        std::cout << "Could not open '" << filePath << "' to save the group by calibration!" << std::endl;
+        exit(1);
+    }
+
+    file << "machineConstant " << parameters.machineConstant << std::endl;
+    file << "tuplesPerChunk " << parameters.tuplesPerChunk << std::endl;
+    file << "tuplesBetweenHashing " << parameters.tuplesBetweenHashing << std::endl;
+}
+
 }
\ No newline at end of file
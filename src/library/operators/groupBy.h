@@ -4,6 +4,9 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <tuple>
+#include <cstdint>
+#include <type_traits>
 
 
 namespace MABPL {
@@ -11,32 +14,135 @@ namespace MABPL {
 enum GroupBy {
     Hash,
     Sort,
+    Dense,
+    Hybrid,
     Adaptive,
 };
 
 std::string getGroupByName(GroupBy groupByImplementation);
 
+// Thresholds of the adaptive group by. The defaults were measured on the development machine and are replaced by the
+// values in the calibration file, written by groupByAdaptiveCalibrationBenchmark, when one exists. The file is read from
+// the path in MABPL_GROUPBY_CALIBRATION_FILE, or groupByCalibration.txt in the working directory.
+struct GroupByAdaptiveParameters {
+    float machineConstant;
+    int tuplesPerChunk;
+    int tuplesBetweenHashing;
+};
+
+const GroupByAdaptiveParameters &getGroupByAdaptiveParameters();
+void setGroupByAdaptiveParameters(const GroupByAdaptiveParameters &parameters);
+std::string getGroupByCalibrationFilePath();
+bool loadGroupByAdaptiveParameters(const std::string &filePath, GroupByAdaptiveParameters &parameters);
+void saveGroupByAdaptiveParameters(const std::string &filePath, const GroupByAdaptiveParameters &parameters);
+
 template<typename T1, typename T2>
 using vectorOfPairs = std::vector<std::pair<T1, T2>>;
 
+template<typename T>
+constexpr bool isGroupByKeyType = std::is_integral<T>::value || std::is_same<T, unsigned __int128>::value;
+
+// Aggregators are used through init / update / merge / finalize: a State is created from the first value of a group,
+// updated with each further value, merged with States built over other partitions, then finalized into a Result.
+// The call operator is the single column form used by groupByHash, groupBySort and groupByAdaptive.
+
 template<typename T>
 struct MinAggregation {
+    using State = T;
+    using Result = T;
     T operator()(T currentAggregate, T numberToInclude, bool firstAggregation) const;
+    static State init(T value);
+    static void update(State &state, T value);
+    static void merge(State &state, const State &other);
+    static Result finalize(const State &state);
 };
 
 template<typename T>
 struct MaxAggregation {
+    using State = T;
+    using Result = T;
     T operator()(T currentAggregate, T numberToInclude, bool firstAggregation) const;
+    static State init(T value);
+    static void update(State &state, T value);
+    static void merge(State &state, const State &other);
+    static Result finalize(const State &state);
 };
 
 template<typename T>
 struct SumAggregation {
+    using State = T;
+    using Result = T;
     T operator()(T currentAggregate, T numberToInclude, bool firstAggregation) const;
+    static State init(T value);
+    static void update(State &state, T value);
+    static void merge(State &state, const State &other);
+    static Result finalize(const State &state);
 };
 
 template<typename T>
 struct CountAggregation {
+    using State = T;
+    using Result = T;
     T operator()(T currentAggregate, T _, bool firstAggregation) const;
+    static State init(T _);
+    static void update(State &state, T _);
+    static void merge(State &state, const State &other);
+    static Result finalize(const State &state);
+};
+
+// Integer columns are summed in 64 bits of their own signedness
+template<typename T>
+struct AverageAggregation {
+    struct State {
+        std::conditional_t<std::is_integral<T>::value,
+                           std::conditional_t<std::is_unsigned<T>::value, uint64_t, int64_t>, double> sum;
+        int64_t count;
+    };
+    using Result = double;
+    static State init(T value);
+    static void update(State &state, T value);
+    static void merge(State &state, const State &other);
+    static Result finalize(const State &state);
+};
+
+// Population variance, accumulated with Welford's update and Chan's merge to avoid cancellation in sum of squares
+template<typename T>
+struct VarianceAggregation {
+    struct State {
+        int64_t count;
+        double mean;
+        double sumSquaredDifferences;
+    };
+    using Result = double;
+    static State init(T value);
+    static void update(State &state, T value);
+    static void merge(State &state, const State &other);
+    static Result finalize(const State &state);
+};
+
+template<typename T>
+struct StandardDeviationAggregation : VarianceAggregation<T> {
+    using Result = double;
+    static Result finalize(const typename VarianceAggregation<T>::State &state);
+};
+
+template<template<typename> class Aggregator, typename T>
+struct AggregateColumn {
+    using ValueType = T;
+    using AggregatorType = Aggregator<T>;
+    using StateType = typename Aggregator<T>::State;
+    using ResultType = typename Aggregator<T>::Result;
+    T *input;
+};
+
+template<template<typename> class Aggregator, typename T>
+AggregateColumn<Aggregator, T> aggregateColumn(T *input);
+
+template<typename T1, typename... T2s>
+struct MultiAggregateResult {
+    std::vector<T1> groupBy;
+    std::tuple<std::vector<T2s>...> aggregates;
+    [[nodiscard]] size_t size() const { return groupBy.size(); }
 };
 
 
@@ -46,12 +152,111 @@ vectorOfPairs<T1, T2>  groupByHash(int n, T1 *inputGroupBy, T2 *inputAggregate,
 template<template<typename> class Aggregator, typename T1, typename T2>
 vectorOfPairs<T1, T2> groupBySort(int n, T1 *inputGroupBy, T2 *inputAggregate);
 
+// Aggregates directly into an array indexed by key offset from the minimum key. Falls back to groupBySort when the key
+// range is larger than the input.
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByDense(int n, T1 *inputGroupBy, T2 *inputAggregate);
+
+// Pre-aggregates into a hash table sized to a fraction of the last level cache. Keys that miss a full table are written
+// to an overflow run that is aggregated partition by partition with radix passes once the input is consumed.
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByHybrid(int n, T1 *inputGroupBy, T2 *inputAggregate);
+
 template<template<typename> class Aggregator, typename T1, typename T2>
 vectorOfPairs<T1, T2> groupByAdaptive(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality);
 
 template<template<typename> class Aggregator, typename T1, typename T2>
 vectorOfPairs<T1, T2> runGroupByFunction(GroupBy groupByImplementation, int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality);
 
+// Columnar forms write the groups into caller-provided key and aggregate arrays and return the number of groups. The
+// arrays need room for one entry per distinct key, which n always bounds.
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupByHash(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality, T1 *outputGroupBy,
+                T2 *outputAggregate);
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupBySort(int n, T1 *inputGroupBy, T2 *inputAggregate, T1 *outputGroupBy, T2 *outputAggregate);
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupByDense(int n, T1 *inputGroupBy, T2 *inputAggregate, T1 *outputGroupBy, T2 *outputAggregate);
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupByHybrid(int n, T1 *inputGroupBy, T2 *inputAggregate, T1 *outputGroupBy, T2 *outputAggregate);
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupByAdaptive(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality, T1 *outputGroupBy,
+                    T2 *outputAggregate);
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int runGroupByFunction(GroupBy groupByImplementation, int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality,
+                       T1 *outputGroupBy, T2 *outputAggregate);
+
+// Keeps the memory allocated beyond the input and result within memoryBudgetBytes. When groupBySort's copy buffers would
+// exceed the budget, the input is hash partitioned into temporary files with block writes and each partition is
+// then read back and aggregated in a hash table reserved for its tuples. Partitions whose table would not fit in half
+// the budget, e.g. under skew, are partitioned again on the next bits of the hash. The bound does not hold for budgets
+// below a few megabytes, as partitions are not re-spilled once their table fits in a megabyte and every partition
+// keeps a write block of at least one tuple, nor for a partition that a fresh hash cannot split, whose few keys are
+// aggregated in a table left to grow.
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupBySpill(int n, T1 *inputGroupBy, T2 *inputAggregate, long memoryBudgetBytes);
+
+// Overloads without a cardinality hint size the hash table from a HyperLogLog estimate over a sample of the keys
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByHash(int n, T1 *inputGroupBy, T2 *inputAggregate);
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByAdaptive(int n, T1 *inputGroupBy, T2 *inputAggregate);
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> runGroupByFunction(GroupBy groupByImplementation, int n, T1 *inputGroupBy, T2 *inputAggregate);
+
+
+// Groups by 2-4 key columns. Keys are offset by their column minimum and bit-packed into a single 64 or 128-bit key
+// (first column most significant) so that every GroupBy implementation runs on the packed column. Key sets wider than
+// 128 bits fall back to hashing an unpacked array of the offsets.
+template<template<typename> class Aggregator, typename T2, typename... KeyTypes>
+vectorOfPairs<std::tuple<KeyTypes...>, T2> groupByCompositeKey(GroupBy groupByImplementation, int n,
+                                                               std::tuple<KeyTypes *...> inputGroupBy,
+                                                               T2 *inputAggregate, int cardinality);
+
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByHashMultiAggregate(
+        int n, T1 *inputGroupBy, int cardinality, AggregateColumns... aggregateColumns);
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupBySortMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns);
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByDenseMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns);
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByHybridMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns);
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByAdaptiveMultiAggregate(
+        int n, T1 *inputGroupBy, int cardinality, AggregateColumns... aggregateColumns);
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> runGroupByMultiAggregateFunction(
+        GroupBy groupByImplementation, int n, T1 *inputGroupBy, int cardinality, AggregateColumns... aggregateColumns);
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByHashMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns);
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByAdaptiveMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns);
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> runGroupByMultiAggregateFunction(
+        GroupBy groupByImplementation, int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns);
+
 }
 
 #include "groupByImplementation.h"
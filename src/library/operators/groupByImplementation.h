@@ -4,16 +4,264 @@
 
 #include <iostream>
 #include <limits>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include <array>
+#include <cstdio>
+#include <immintrin.h>
 #include "tsl/robin_map.h"
 
+#include "partition.h"
 #include "../utilities/systemInformation.h"
 #include "../utilities/papi.h"
+#include "../utilities/cardinalityEstimation.h"
+#include "../utilities/memoryArena.h"
+#include "../utilities/hugePages.h"
 
 
 namespace MABPL {
 
-constexpr int BITS_PER_RADIX_PASS = 10;
+constexpr int RADIX_MAX_PASSES = 32;
+constexpr int RADIX_MIN_BITS_PER_PASS = 4;
+constexpr int RADIX_MAX_BITS_PER_PASS = 16;
 constexpr float GROUPBY_MACHINE_CONSTANT = 0.125;
+constexpr int GROUPBY_TUPLES_PER_CHUNK = 75 * 1000;
+constexpr int GROUPBY_TUPLES_BETWEEN_HASHING = 2 * 1000 * 1000;
+constexpr int GROUPBY_SORT_FROM_START_LLC_MULTIPLE = 4;
+constexpr float GROUPBY_HYBRID_LLC_FRACTION = 0.5;
+constexpr long GROUPBY_SPILL_BLOCK_BYTES = 1 << 20;
+constexpr int GROUPBY_SPILL_MAX_PARTITION_BITS = 8;
+constexpr long GROUPBY_ADAPTIVE_BACKLOG_BYTES = 1L << 28;
+constexpr int GROUPBY_RUN_SAMPLE_TUPLES = 1024;
+constexpr int GROUPBY_MIN_AVERAGE_RUN_LENGTH = 2;
+
+template<typename T>
+struct GroupByKeyHash : std::hash<T> {};
+
+template<>
+struct GroupByKeyHash<unsigned __int128> {
+    size_t operator()(unsigned __int128 key) const {
+        uint64_t hash = static_cast<uint64_t>(key) ^ (static_cast<uint64_t>(key >> 64) * 0x9E3779B97F4A7C15ULL);
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        return hash ^ (hash >> 33);
+    }
+};
+
+template<size_t N>
+struct GroupByKeyHash<std::array<uint64_t, N>> {
+    size_t operator()(const std::array<uint64_t, N> &key) const {
+        uint64_t hash = 0;
+        for (size_t i = 0; i < N; ++i) {
+            hash = (hash ^ key[i]) * 0x9E3779B97F4A7C15ULL;
+            hash ^= hash >> 32;
+        }
+        return hash;
+    }
+};
+
+// Bucket arrays of large tables are huge-page backed to cut the data TLB misses of random probes
+template<typename Key, typename Value>
+using groupByHashMap = tsl::robin_map<Key, Value, GroupByKeyHash<Key>, std::equal_to<Key>,
+                                      HugePageAllocator<std::pair<Key, Value>>>;
+
+// The group by implementations write through reserve / emplace_back, so the same code fills a vectorOfPairs or a
+// caller's key and aggregate columns
+template<typename T1, typename T2>
+struct ColumnarGroupByOutput {
+    T1 *groupBy;
+    T2 *aggregate;
+    size_t count;
+    void reserve(size_t) {}
+    [[nodiscard]] size_t size() const { return count; }
+    void emplace_back(T1 key, T2 value) {
+        groupBy[count] = key;
+        aggregate[count++] = value;
+    }
+};
+
+template<typename T1, typename T2, typename Output>
+inline void writeGroupByMap(const groupByHashMap<T1, T2> &map, Output &result) {
+    result.reserve(result.size() + map.size());
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        result.emplace_back(it->first, it->second);
+    }
+}
+
+template<typename T>
+inline T radixLeafKey(T keyInLeaf, T minimum, int mask, int bucket) {
+    using U = typename RadixKey<T>::type;
+    U prefix = radixOffset(keyInLeaf, minimum) & ~static_cast<U>(mask);
+    return static_cast<T>((prefix | static_cast<U>(bucket)) + static_cast<U>(minimum));
+}
+
+// Bit widths of the radix passes over the key offsets. Pass 0 is the leaf pass, whose buckets index the aggregation
+// array of a partition, and count - 1 is the top pass.
+struct RadixPasses {
+    int count;
+    int maxBuckets;
+    int shift[RADIX_MAX_PASSES];
+    int bits[RADIX_MAX_PASSES];
+
+    [[nodiscard]] int numBuckets(int pass) const { return 1 << bits[pass]; }
+    [[nodiscard]] int mask(int pass) const { return numBuckets(pass) - 1; }
+};
+
+inline int radixFloorLog2(long value) {
+    int log = 0;
+    while (value > 1) {
+        value >>= 1;
+        log++;
+    }
+    return log;
+}
+
+// The leaf aggregation array, one entry per bucket, must stay within half of L1
+inline int radixLeafBits(int leafEntryBytes) {
+    static const long l1Bytes = l1cacheSize() > 0 ? l1cacheSize() : 32 * 1024;
+    int bits = radixFloorLog2(l1Bytes / (2 * leafEntryBytes));
+    return std::clamp(bits, RADIX_MIN_BITS_PER_PASS, RADIX_MAX_BITS_PER_PASS);
+}
+
+// A partitioning pass writes to one cache line and one page per bucket, so the fan-out is bounded by the data TLB
+// entries and by half of the lines in L2
+inline int radixPartitionBits() {
+    static const int bits = [] {
+        long l2Bytes = l2cacheSize() > 0 ? l2cacheSize() : 256 * 1024;
+        long l2Lines = l2Bytes / (bytesPerCacheLine() > 0 ? bytesPerCacheLine() : 64);
+        int fanOutBits = radixFloorLog2(std::min(dataTlbEntries(), l2Lines / 2));
+        return std::clamp(fanOutBits, RADIX_MIN_BITS_PER_PASS, RADIX_MAX_BITS_PER_PASS);
+    }();
+    return bits;
+}
+
+// Only the bits that differ within the key range are partitioned on. The leaf pass takes as many of the low bits as fit
+// its aggregation array and the remaining bits are spread evenly over the fewest partitioning passes.
+template<typename T>
+inline RadixPasses radixPasses(T smallest, T largest, int leafEntryBytes) {
+    auto range = radixOffset(largest, smallest);
+    int keyBits = 0;
+    while (range != 0) {
+        range >>= 1;
+        keyBits++;
+    }
+
+    RadixPasses passes{};
+    passes.shift[0] = 0;
+    passes.bits[0] = std::min(keyBits, radixLeafBits(leafEntryBytes));
+
+    int remainingBits = keyBits - passes.bits[0];
+    int partitionBits = radixPartitionBits();
+    int partitionPasses = (remainingBits + partitionBits - 1) / partitionBits;
+    passes.count = partitionPasses + 1;
+    for (int pass = 1; pass < passes.count; pass++) {
+        int passesLeft = passes.count - pass;
+        passes.shift[pass] = passes.shift[pass - 1] + passes.bits[pass - 1];
+        passes.bits[pass] = (remainingBits + passesLeft - 1) / passesLeft;
+        remainingBits -= passes.bits[pass];
+    }
+
+    passes.maxBuckets = 1;
+    for (int pass = 0; pass < passes.count; pass++) {
+        passes.maxBuckets = std::max(passes.maxBuckets, passes.numBuckets(pass));
+    }
+    return passes;
+}
+
+template<typename T>
+inline void keyRange(int n, const T *input, T &smallest, T &largest) {
+    for (int i = 0; i < n; i++) {
+        smallest = std::min(smallest, input[i]);
+        largest = std::max(largest, input[i]);
+    }
+}
+
+// A key domain is dense when an array indexed by key offset is no larger than the input, so initialising and scanning
+// the array costs no more than the aggregation itself
+template<typename T>
+inline bool denseKeyDomain(int n, T smallest, T largest) {
+    return radixOffset(largest, smallest) < static_cast<typename RadixKey<T>::type>(n);
+}
+
+template<typename T>
+inline T denseKey(int offset, T minimum) {
+    using U = typename RadixKey<T>::type;
+    return static_cast<T>(static_cast<U>(minimum) + static_cast<U>(offset));
+}
+
+// Number of keys from start that equal input[start], compared a vector at a time for 32 and 64-bit keys
+template<typename T>
+inline int keyRunLength(int start, int end, const T *input) {
+    int i = start + 1;
+#ifdef __AVX2__
+    if constexpr (std::is_integral<T>::value && sizeof(T) == 4) {
+        __m256i runKey = _mm256_set1_epi32(static_cast<int>(input[start]));
+        for (; i + 8 <= end; i += 8) {
+            auto equal = static_cast<unsigned int>(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(input + i)), runKey)));
+            if (equal != 0xFFFFFFFF) {
+                return i - start + __builtin_ctz(~equal) / 4;
+            }
+        }
+    } else if constexpr (std::is_integral<T>::value && sizeof(T) == 8) {
+        __m256i runKey = _mm256_set1_epi64x(static_cast<long long>(input[start]));
+        for (; i + 4 <= end; i += 4) {
+            auto equal = static_cast<unsigned int>(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(input + i)), runKey)));
+            if (equal != 0xFFFFFFFF) {
+                return i - start + __builtin_ctz(~equal) / 8;
+            }
+        }
+    }
+#endif
+    while (i < end && input[i] == input[start]) {
+        i++;
+    }
+    return i - start;
+}
+
+// Samples the start of a chunk for runs of equal keys long enough that aggregating each run before probing the hash
+// table saves more probes than the run detection costs
+template<typename T>
+inline bool keysHaveRuns(int n, const T *input) {
+    int sampleSize = std::min(n, GROUPBY_RUN_SAMPLE_TUPLES);
+    int runs = 1;
+    for (int i = 1; i < sampleSize; i++) {
+        runs += input[i] != input[i - 1];
+    }
+    return runs * GROUPBY_MIN_AVERAGE_RUN_LENGTH <= sampleSize;
+}
+
+template<typename T>
+inline bool keysSorted(int n, const T *input) {
+    int i = 1;
+#ifdef __AVX2__
+    if constexpr (std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 4) {
+        for (; i + 8 <= n; i += 8) {
+            __m256i descending = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i *)(input + i - 1)),
+                                                    _mm256_loadu_si256((const __m256i *)(input + i)));
+            if (!_mm256_testz_si256(descending, descending)) {
+                return false;
+            }
+        }
+    } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 8) {
+        for (; i + 4 <= n; i += 4) {
+            __m256i descending = _mm256_cmpgt_epi64(_mm256_loadu_si256((const __m256i *)(input + i - 1)),
+                                                    _mm256_loadu_si256((const __m256i *)(input + i)));
+            if (!_mm256_testz_si256(descending, descending)) {
+                return false;
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (input[i] < input[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
 
 template<typename T>
 T MinAggregation<T>::operator()(T currentAggregate, T numberToInclude, bool firstAggregation) const {
@@ -47,154 +295,398 @@ T CountAggregation<T>::operator()(T currentAggregate, T _, bool firstAggregation
     return ++currentAggregate;
 }
 
-template<template<typename> class Aggregator, typename T1, typename T2>
-inline void groupByHashAux(int n, T1 *inputGroupBy, T2 *inputAggregate, tsl::robin_map<T1, T2> &map, int &index) {
-    typename tsl::robin_map<T1, T2>::iterator it;
-    int startingIndex = index;
-    for (; index < startingIndex + n; ++index) {
+template<typename T>
+typename MinAggregation<T>::State MinAggregation<T>::init(T value) {
+    return value;
+}
+
+template<typename T>
+void MinAggregation<T>::update(State &state, T value) {
+    state = std::min(state, value);
+}
+
+template<typename T>
+void MinAggregation<T>::merge(State &state, const State &other) {
+    state = std::min(state, other);
+}
+
+template<typename T>
+typename MinAggregation<T>::Result MinAggregation<T>::finalize(const State &state) {
+    return state;
+}
+
+template<typename T>
+typename MaxAggregation<T>::State MaxAggregation<T>::init(T value) {
+    return value;
+}
+
+template<typename T>
+void MaxAggregation<T>::update(State &state, T value) {
+    state = std::max(state, value);
+}
+
+template<typename T>
+void MaxAggregation<T>::merge(State &state, const State &other) {
+    state = std::max(state, other);
+}
+
+template<typename T>
+typename MaxAggregation<T>::Result MaxAggregation<T>::finalize(const State &state) {
+    return state;
+}
+
+template<typename T>
+typename SumAggregation<T>::State SumAggregation<T>::init(T value) {
+    return value;
+}
+
+template<typename T>
+void SumAggregation<T>::update(State &state, T value) {
+    state += value;
+}
+
+template<typename T>
+void SumAggregation<T>::merge(State &state, const State &other) {
+    state += other;
+}
+
+template<typename T>
+typename SumAggregation<T>::Result SumAggregation<T>::finalize(const State &state) {
+    return state;
+}
+
+template<typename T>
+typename CountAggregation<T>::State CountAggregation<T>::init(T _) {
+    return 1;
+}
+
+template<typename T>
+void CountAggregation<T>::update(State &state, T _) {
+    ++state;
+}
+
+template<typename T>
+void CountAggregation<T>::merge(State &state, const State &other) {
+    state += other;
+}
+
+template<typename T>
+typename CountAggregation<T>::Result CountAggregation<T>::finalize(const State &state) {
+    return state;
+}
+
+template<typename T>
+typename AverageAggregation<T>::State AverageAggregation<T>::init(T value) {
+    return {static_cast<decltype(State::sum)>(value), 1};
+}
+
+template<typename T>
+void AverageAggregation<T>::update(State &state, T value) {
+    state.sum += value;
+    ++state.count;
+}
+
+template<typename T>
+void AverageAggregation<T>::merge(State &state, const State &other) {
+    state.sum += other.sum;
+    state.count += other.count;
+}
+
+template<typename T>
+typename AverageAggregation<T>::Result AverageAggregation<T>::finalize(const State &state) {
+    return static_cast<double>(state.sum) / static_cast<double>(state.count);
+}
+
+template<typename T>
+typename VarianceAggregation<T>::State VarianceAggregation<T>::init(T value) {
+    return {1, static_cast<double>(value), 0};
+}
+
+template<typename T>
+void VarianceAggregation<T>::update(State &state, T value) {
+    ++state.count;
+    double delta = static_cast<double>(value) - state.mean;
+    state.mean += delta / static_cast<double>(state.count);
+    state.sumSquaredDifferences += delta * (static_cast<double>(value) - state.mean);
+}
+
+template<typename T>
+void VarianceAggregation<T>::merge(State &state, const State &other) {
+    int64_t count = state.count + other.count;
+    double delta = other.mean - state.mean;
+    state.mean += delta * static_cast<double>(other.count) / static_cast<double>(count);
+    state.sumSquaredDifferences += other.sumSquaredDifferences + delta * delta *
+            (static_cast<double>(state.count) * static_cast<double>(other.count) / static_cast<double>(count));
+    state.count = count;
+}
+
+template<typename T>
+typename VarianceAggregation<T>::Result VarianceAggregation<T>::finalize(const State &state) {
+    return state.sumSquaredDifferences / static_cast<double>(state.count);
+}
+
+template<typename T>
+typename StandardDeviationAggregation<T>::Result StandardDeviationAggregation<T>::finalize(
+        const typename VarianceAggregation<T>::State &state) {
+    return std::sqrt(VarianceAggregation<T>::finalize(state));
+}
+
+// Aggregates each run of equal keys in registers and probes the hash table once per run. With trackRange, the range of
+// the keys inserted into the table is widened in smallest and largest.
+template<template<typename> class Aggregator, bool trackRange = true, typename T1, typename T2>
+inline void groupByHashRunsAux(int n, const T1 *inputGroupBy, const T2 *inputAggregate, groupByHashMap<T1, T2> &map,
+                               int &index, T1 &smallest, T1 &largest) {
+    typename groupByHashMap<T1, T2>::iterator it;
+    int end = index + n;
+    int runLength;
+    T2 aggregate;
+    for (; index < end; index += runLength) {
+        runLength = keyRunLength(index, end, inputGroupBy);
+        aggregate = Aggregator<T2>::init(inputAggregate[index]);
+        for (int i = index + 1; i < index + runLength; i++) {
+            Aggregator<T2>::update(aggregate, inputAggregate[i]);
+        }
+
         it = map.find(inputGroupBy[index]);
         if (it != map.end()) {
-            it.value() = Aggregator<T2>()(it->second, inputAggregate[index], false);
+            Aggregator<T2>::merge(it.value(), aggregate);
         } else {
-            map.insert({inputGroupBy[index], Aggregator<T2>()(0, inputAggregate[index], true)});
+            map.insert({inputGroupBy[index], aggregate});
+            if constexpr (trackRange) {
+                smallest = std::min(smallest, inputGroupBy[index]);
+                largest = std::max(largest, inputGroupBy[index]);
+            }
         }
     }
 }
 
 template<template<typename> class Aggregator, typename T1, typename T2>
-vectorOfPairs<T1, T2> groupByHash(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality) {
-    static_assert(std::is_integral<T1>::value, "GroupBy column must be an integer type");
+inline void groupByHashRunsAux(int n, const T1 *inputGroupBy, const T2 *inputAggregate, groupByHashMap<T1, T2> &map,
+                               int &index) {
+    T1 unusedRange;
+    groupByHashRunsAux<Aggregator, false>(n, inputGroupBy, inputAggregate, map, index, unusedRange, unusedRange);
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+inline void groupByHashAux(int n, T1 *inputGroupBy, T2 *inputAggregate, groupByHashMap<T1, T2> &map, int &index) {
+    typename groupByHashMap<T1, T2>::iterator it;
+    int end = index + n;
+    int chunkEnd;
+    while (index < end) {
+        chunkEnd = std::min(index + GROUPBY_TUPLES_PER_CHUNK, end);
+        if (keysHaveRuns(chunkEnd - index, inputGroupBy + index)) {
+            groupByHashRunsAux<Aggregator>(chunkEnd - index, inputGroupBy, inputAggregate, map, index);
+            continue;
+        }
+        for (; index < chunkEnd; ++index) {
+            it = map.find(inputGroupBy[index]);
+            if (it != map.end()) {
+                it.value() = Aggregator<T2>()(it->second, inputAggregate[index], false);
+            } else {
+                map.insert({inputGroupBy[index], Aggregator<T2>()(0, inputAggregate[index], true)});
+            }
+        }
+    }
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void groupByHashInto(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality, Output &result) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
     static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
 
-    tsl::robin_map<T1, T2> map(std::max(static_cast<int>(2.5 * cardinality), 400000));
+    groupByHashMap<T1, T2> map(std::max(static_cast<int>(2.5 * cardinality), 400000));
 
     int index = 0;
     groupByHashAux<Aggregator>(n, inputGroupBy, inputAggregate, map, index);
 
-    return {map.begin(), map.end()};
+    writeGroupByMap(map, result);
 }
 
-template<template<typename> class Aggregator, typename T1, typename T2>
-void groupBySortAuxAgg(int start, int end, const T1 *inputGroupBy, T2 *inputAggregate, int mask, int numBuckets,
-                       std::vector<int> &buckets, vectorOfPairs <T1, T2> &result) {
+template<template<typename> class Aggregator, bool mergePartials = false, typename T1, typename T2, typename Output>
+void groupBySortAuxAgg(int start, int end, const T1 *inputGroupBy, T2 *inputAggregate, T1 minimum,
+                       const RadixPasses &passes, Output &result) {
     int i;
-    bool bucketEntryPresent[1 << BITS_PER_RADIX_PASS] = {false};
+    int bucket;
+    int numBuckets = passes.numBuckets(0);
+    int mask = passes.mask(0);
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T2 *bucketAggregates = arena.allocate<T2>(numBuckets);
+    bool *bucketEntryPresent = arena.allocate<bool>(numBuckets);
+    std::fill(bucketEntryPresent, bucketEntryPresent + numBuckets, false);
 
     for (i = start; i < end; i++) {
-        buckets[inputGroupBy[i] & mask] = Aggregator<T2>()(buckets[inputGroupBy[i] & mask], inputAggregate[i],
-                                                           !bucketEntryPresent[inputGroupBy[i] & mask]);
-        bucketEntryPresent[inputGroupBy[i] & mask] = true;
+        bucket = radixBucket(inputGroupBy[i], minimum, 0, mask);
+        if constexpr (mergePartials) {
+            if (bucketEntryPresent[bucket]) {
+                Aggregator<T2>::merge(bucketAggregates[bucket], inputAggregate[i]);
+            } else {
+                bucketAggregates[bucket] = inputAggregate[i];
+            }
+        } else if (bucketEntryPresent[bucket]) {
+            bucketAggregates[bucket] = Aggregator<T2>()(bucketAggregates[bucket], inputAggregate[i], false);
+        } else {
+            bucketAggregates[bucket] = Aggregator<T2>()(T2(), inputAggregate[i], true);
+        }
+        bucketEntryPresent[bucket] = true;
     }
 
-    int valuePrefix = inputGroupBy[start] & ~mask;
-
     for (i = 0; i < numBuckets; i++) {
         if (bucketEntryPresent[i]) {
-            result.emplace_back(valuePrefix | i, buckets[i]);
+            result.emplace_back(radixLeafKey(inputGroupBy[start], minimum, mask, i), bucketAggregates[i]);
         }
     }
 
-    std::fill(buckets.begin(), buckets.end(), 0);
+    arena.rewind(arenaMark);
 }
 
-template<template<typename> class Aggregator, typename T1, typename T2>
+template<template<typename> class Aggregator, bool mergePartials = false, typename T1, typename T2, typename Output>
 void groupBySortAux(int start, int end, T1 *inputGroupBy, T2 *inputAggregate, T1 *bufferGroupBy, T2 *bufferAggregate,
-                    int mask, int numBuckets, std::vector<int> &buckets, int pass, vectorOfPairs <T1, T2> &result) {
-    int i;
-
-    for (i = start; i < end; i++) {
-        buckets[(inputGroupBy[i] >> (pass * BITS_PER_RADIX_PASS)) & mask]++;
-    }
-
-    for (i = 1; i < numBuckets; i++) {
-        buckets[i] += buckets[i - 1];
-    }
-
-    std::vector<int> partitions(buckets.data(), buckets.data() + numBuckets);
-    for (i = 0; i < numBuckets; i++) {
-        partitions[i] += start;
-    }
+                    T1 minimum, const RadixPasses &passes, int pass, Output &result) {
+    int shift = passes.shift[pass];
+    int numBuckets = passes.numBuckets(pass);
+    int mask = passes.mask(pass);
 
-    for (i = end - 1; i >= start; i--) {
-        bufferGroupBy[start + --buckets[(inputGroupBy[i] >> (pass * BITS_PER_RADIX_PASS)) & mask]] = inputGroupBy[i];
-        bufferAggregate[start + buckets[(inputGroupBy[i] >> (pass * BITS_PER_RADIX_PASS)) & mask]] = inputAggregate[i];
-    }
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    int *partitions = arena.allocate<int>(numBuckets + 1);
+    partitionAux(start, end, inputGroupBy, inputAggregate, bufferGroupBy, bufferAggregate, numBuckets,
+                 [minimum, shift, mask](T1 key) { return radixBucket(key, minimum, shift, mask); }, partitions);
 
-    std::fill(buckets.begin(), buckets.end(), 0);
     std::swap(inputGroupBy, bufferGroupBy);
     std::swap(inputAggregate, bufferAggregate);
     --pass;
 
-    if (pass > 0) {
-        if (partitions[0] > start) {
-            groupBySortAux<Aggregator>(start, partitions[0], inputGroupBy, inputAggregate,
-                                       bufferGroupBy,
-                                       bufferAggregate, mask, numBuckets, buckets, pass, result);
-        }
-        for (i = 1; i < numBuckets; i++) {
-            if (partitions[i] > partitions[i - 1]) {
-                groupBySortAux<Aggregator>(partitions[i - 1], partitions[i], inputGroupBy,
-                                           inputAggregate,
-                                           bufferGroupBy, bufferAggregate, mask, numBuckets, buckets,
-                                           pass, result);
-            }
+    for (int i = 0; i < numBuckets; i++) {
+        if (partitions[i + 1] == partitions[i]) {
+            continue;
         }
-    } else {
-        if (partitions[0] > start) {
-            groupBySortAuxAgg<Aggregator>(start, partitions[0], inputGroupBy, inputAggregate,
-                                          mask, numBuckets, buckets, result);
+        if (pass > 0) {
+            groupBySortAux<Aggregator, mergePartials>(partitions[i], partitions[i + 1], inputGroupBy, inputAggregate,
+                                                      bufferGroupBy, bufferAggregate, minimum, passes, pass, result);
+        } else {
+            groupBySortAuxAgg<Aggregator, mergePartials>(partitions[i], partitions[i + 1], inputGroupBy,
+                                                         inputAggregate, minimum, passes, result);
         }
-        for (i = 1; i < numBuckets; i++) {
-            if (partitions[i] > partitions[i - 1]) {
-                groupBySortAuxAgg<Aggregator>(partitions[i - 1], partitions[i], inputGroupBy,
-                                              inputAggregate,
-                                              mask, numBuckets, buckets, result);
-            }
+    }
+
+    arena.rewind(arenaMark);
+}
+
+// Input already in key order is aggregated run by run, giving the same key ordered output as the radix sort
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void groupBySortedInto(int n, const T1 *inputGroupBy, const T2 *inputAggregate, Output &result) {
+    int runLength;
+    T2 aggregate;
+    for (int index = 0; index < n; index += runLength) {
+        runLength = keyRunLength(index, n, inputGroupBy);
+        aggregate = Aggregator<T2>::init(inputAggregate[index]);
+        for (int i = index + 1; i < index + runLength; i++) {
+            Aggregator<T2>::update(aggregate, inputAggregate[i]);
         }
+        result.emplace_back(inputGroupBy[index], aggregate);
     }
 }
 
-template<template<typename> class Aggregator, typename T1, typename T2>
-vectorOfPairs<T1, T2> groupBySort(int n, T1 *inputGroupBy, T2 *inputAggregate) {
-    static_assert(std::is_integral<T1>::value, "GroupBy column must be an integer type");
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void groupBySortInto(int n, T1 *inputGroupBy, T2 *inputAggregate, Output &result) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
     static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
 
+    if (n == 0) {
+        return;
+    }
+
+    if (keysSorted(n, inputGroupBy)) {
+        groupBySortedInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+        return;
+    }
+
+    T1 smallest = inputGroupBy[0];
+    T1 largest = inputGroupBy[0];
+    keyRange(n, inputGroupBy, smallest, largest);
+    RadixPasses passes = radixPasses(smallest, largest, sizeof(T2) + sizeof(bool));
+
+    // A key range that fits the leaf aggregation array is aggregated without partitioning
+    if (passes.count == 1) {
+        groupBySortAuxAgg<Aggregator>(0, n, inputGroupBy, inputAggregate, smallest, passes, result);
+        return;
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *bufferGroupBy = arena.allocate<T1>(n);
+    T2 *bufferAggregate = arena.allocate<T2>(n);
+
+    groupBySortAux<Aggregator>(0, n, inputGroupBy, inputAggregate, bufferGroupBy,
+                               bufferAggregate, smallest, passes, passes.count - 1, result);
+
+    arena.rewind(arenaMark);
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void groupByDenseAux(int n, const T1 *inputGroupBy, const T2 *inputAggregate, T1 smallest, T1 largest,
+                     Output &result) {
     int i;
-    int numBuckets = 1 << BITS_PER_RADIX_PASS;
-    int mask = numBuckets - 1;
-    int largest = 0;
+    int offset;
+    int domainSize = static_cast<int>(radixOffset(largest, smallest)) + 1;
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T2 *aggregates = arena.allocate<T2>(domainSize);
+    bool *entryPresent = arena.allocate<bool>(domainSize);
+    std::fill(entryPresent, entryPresent + domainSize, false);
 
     for (i = 0; i < n; i++) {
-        if (inputGroupBy[i] > largest) {
-            largest = inputGroupBy[i];
-        }
+        offset = static_cast<int>(radixOffset(inputGroupBy[i], smallest));
+        aggregates[offset] = Aggregator<T2>()(aggregates[offset], inputAggregate[i], !entryPresent[offset]);
+        entryPresent[offset] = true;
     }
-    int msbPosition = 0;
-    while (largest != 0) {
-        largest >>= 1;
-        msbPosition++;
+
+    for (i = 0; i < domainSize; i++) {
+        if (entryPresent[i]) {
+            result.emplace_back(denseKey(i, smallest), aggregates[i]);
+        }
     }
 
-    int pass = static_cast<int>(std::ceil(static_cast<double>(msbPosition) / BITS_PER_RADIX_PASS)) - 1;
-    vectorOfPairs<T1, T2> result;
+    arena.rewind(arenaMark);
+}
 
-    std::vector<int> buckets(1 << BITS_PER_RADIX_PASS, 0);
-    T1 *bufferGroupBy = new T1[n];
-    T2 *bufferAggregate = new T2[n];
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void groupByDenseInto(int n, T1 *inputGroupBy, T2 *inputAggregate, Output &result) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
 
-    groupBySortAux<Aggregator>(0, n, inputGroupBy, inputAggregate, bufferGroupBy,
-                               bufferAggregate, mask, numBuckets, buckets, pass, result);
+    if (n == 0) {
+        return;
+    }
 
-    delete[]bufferGroupBy;
-    delete[]bufferAggregate;
+    T1 smallest = inputGroupBy[0];
+    T1 largest = inputGroupBy[0];
+    keyRange(n, inputGroupBy, smallest, largest);
 
-    return result;
+    if (!denseKeyDomain(n, smallest, largest)) {
+        groupBySortInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+        return;
+    }
+    groupByDenseAux<Aggregator>(n, inputGroupBy, inputAggregate, smallest, largest, result);
+}
+
+// A hash table expected to be several times larger than the last level cache misses on almost every probe, so the
+// first section is sorted without hashing a chunk to read the counters
+inline bool groupBySortFromStart(int cardinality, int hashTableEntryBytes) {
+    return static_cast<long>(cardinality) * hashTableEntryBytes > GROUPBY_SORT_FROM_START_LLC_MULTIPLE * l3cacheSize();
 }
 
 template<template<typename> class Aggregator, typename T1, typename T2>
-inline void groupByAdaptiveAuxHash(int n, T1 *inputGroupBy, T2 *inputAggregate, tsl::robin_map<T1, T2> &map,
-                                   int &index, T1 &largest) {
-    typename tsl::robin_map<T1, T2>::iterator it;
+inline void groupByAdaptiveAuxHash(int n, T1 *inputGroupBy, T2 *inputAggregate, groupByHashMap<T1, T2> &map,
+                                   int &index, T1 &smallest, T1 &largest) {
+    if (keysHaveRuns(n, inputGroupBy + index)) {
+        groupByHashRunsAux<Aggregator>(n, inputGroupBy, inputAggregate, map, index, smallest, largest);
+        return;
+    }
+
+    typename groupByHashMap<T1, T2>::iterator it;
     int startingIndex = index;
     for (; index < startingIndex + n; ++index) {
         it = map.find(inputGroupBy[index]);
@@ -202,140 +694,175 @@ inline void groupByAdaptiveAuxHash(int n, T1 *inputGroupBy, T2 *inputAggregate,
             it.value() = Aggregator<T2>()(it->second, inputAggregate[index], false);
         } else {
             map.insert({inputGroupBy[index], Aggregator<T2>()(0, inputAggregate[index], true)});
+            smallest = std::min(smallest, inputGroupBy[index]);
             largest = std::max(largest, inputGroupBy[index]);
         }
     }
 }
 
-template<template<typename> class Aggregator, typename T1, typename T2>
-vectorOfPairs<T1, T2> groupByAdaptiveAuxSort(int n, T1 *inputGroupBy, T2 *inputAggregate,
-                                             vectorOfPairs<int, int> &sectionsToBeSorted,
-                                             tsl::robin_map<T1, T2> &map, T1 largest,
-                                             vectorOfPairs<T1, T2> &result) {
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void groupByAdaptiveAuxSort(int n, T1 *inputGroupBy, T2 *inputAggregate, vectorOfPairs<int, int> &sectionsToBeSorted,
+                            groupByHashMap<T1, T2> &map, const vectorOfPairs<T1, T2> &mergedRun, T1 smallest,
+                            T1 largest, Output &result) {
     int i;
     for (const auto& section : sectionsToBeSorted) {
-        for (i = section.first; i < section.second; i++) {
-            largest = std::max(largest, inputGroupBy[i]);
-        }
+        keyRange(section.second - section.first, inputGroupBy + section.first, smallest, largest);
     }
-
-    int msbPosition = 0;
-    while (largest != 0) {
-        largest >>= 1;
-        msbPosition++;
+    if (!mergedRun.empty()) {
+        smallest = std::min(smallest, mergedRun.front().first);
+        largest = std::max(largest, mergedRun.back().first);
     }
+    T1 minimum = smallest;
+    RadixPasses passes = radixPasses(smallest, largest, sizeof(T2) + sizeof(bool));
+    int pass = passes.count - 1;
+    int shift = passes.shift[pass];
+    int numBuckets = passes.numBuckets(pass);
+    int mask = passes.mask(pass);
+    std::vector<int> buckets(passes.maxBuckets, 0);
 
-    int pass = static_cast<int>(std::ceil(static_cast<double>(msbPosition) / BITS_PER_RADIX_PASS)) - 1;
-
-    int numBuckets = 1 << BITS_PER_RADIX_PASS;
-    std::vector<int> buckets(1 << BITS_PER_RADIX_PASS, 0);
-
-    int mask = numBuckets - 1;
-
-    T1 *bufferGroupBy = new T1[n];
-    T2 *bufferAggregate = new T2[n];
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *bufferGroupBy = arena.allocate<T1>(n);
+    T2 *bufferAggregate = arena.allocate<T2>(n);
 
 
     for (const auto& section : sectionsToBeSorted) {
         for (i = section.first; i < section.second; i++) {
-            buckets[(inputGroupBy[i] >> (pass * BITS_PER_RADIX_PASS)) & mask]++;
+            buckets[radixBucket(inputGroupBy[i], minimum, shift, mask)]++;
         }
     }
     for (auto it = map.begin(); it != map.end(); ++it) {
-        buckets[(it->first >> (pass * BITS_PER_RADIX_PASS)) & mask]++;
+        buckets[radixBucket(it->first, minimum, shift, mask)]++;
+    }
+    for (const auto& entry : mergedRun) {
+        buckets[radixBucket(entry.first, minimum, shift, mask)]++;
     }
 
     for (i = 1; i < numBuckets; i++) {
         buckets[i] += buckets[i - 1];
     }
 
-    std::vector<int> partitions(buckets.data(), buckets.data() + numBuckets);
+    int *partitions = arena.allocate<int>(numBuckets);
+    std::copy(buckets.begin(), buckets.begin() + numBuckets, partitions);
 
+    // Hash table and merged run entries are already partial aggregates, so sorted rows are converted to partials as
+    // they are scattered and every leaf merges rather than aggregates
     for (auto it = map.begin(); it != map.end(); it++) {
-        bufferGroupBy[--buckets[(it->first >> (pass * BITS_PER_RADIX_PASS)) & mask]] = it->first;
-        bufferAggregate[buckets[(it->first >> (pass * BITS_PER_RADIX_PASS)) & mask]] = it->second;
+        bufferGroupBy[--buckets[radixBucket(it->first, minimum, shift, mask)]] = it->first;
+        bufferAggregate[buckets[radixBucket(it->first, minimum, shift, mask)]] = it->second;
     }
-    for (const auto& section : vectorOfPairs<int, int>(sectionsToBeSorted.rbegin(), sectionsToBeSorted.rend())) {
-        for (i = section.first; i < section.second; i++) {
-            bufferGroupBy[--buckets[(inputGroupBy[i] >> (pass * BITS_PER_RADIX_PASS)) & mask]] = inputGroupBy[i];
-            bufferAggregate[buckets[(inputGroupBy[i] >> (pass * BITS_PER_RADIX_PASS)) & mask]] = inputAggregate[i];
+    for (const auto& entry : mergedRun) {
+        bufferGroupBy[--buckets[radixBucket(entry.first, minimum, shift, mask)]] = entry.first;
+        bufferAggregate[buckets[radixBucket(entry.first, minimum, shift, mask)]] = entry.second;
+    }
+    for (auto section = sectionsToBeSorted.rbegin(); section != sectionsToBeSorted.rend(); ++section) {
+        for (i = section->first; i < section->second; i++) {
+            bufferGroupBy[--buckets[radixBucket(inputGroupBy[i], minimum, shift, mask)]] = inputGroupBy[i];
+            bufferAggregate[buckets[radixBucket(inputGroupBy[i], minimum, shift, mask)]] =
+                    Aggregator<T2>::init(inputAggregate[i]);
         }
     }
 
-    std::fill(buckets.begin(), buckets.end(), 0);
+    std::fill(buckets.begin(), buckets.begin() + numBuckets, 0);
     std::swap(inputGroupBy, bufferGroupBy);
     std::swap(inputAggregate, bufferAggregate);
     --pass;
 
     if (pass > 0) {
         if (partitions[0] > 0) {
-            groupBySortAux<Aggregator>(0, partitions[0], inputGroupBy, inputAggregate,
-                                       bufferGroupBy, bufferAggregate, mask, numBuckets, buckets,
-                                       pass, result);
+            groupBySortAux<Aggregator, true>(0, partitions[0], inputGroupBy, inputAggregate,
+                                             bufferGroupBy, bufferAggregate, minimum, passes, pass, result);
         }
         for (i = 1; i < numBuckets; i++) {
             if (partitions[i] > partitions[i - 1]) {
-                groupBySortAux<Aggregator>(partitions[i - 1], partitions[i], inputGroupBy,
-                                           inputAggregate, bufferGroupBy, bufferAggregate, mask,
-                                           numBuckets, buckets, pass, result);
+                groupBySortAux<Aggregator, true>(partitions[i - 1], partitions[i], inputGroupBy,
+                                                 inputAggregate, bufferGroupBy, bufferAggregate, minimum,
+                                                 passes, pass, result);
             }
         }
     } else {
         if (partitions[0] > 0) {
-            groupBySortAuxAgg<Aggregator>(0, partitions[0], inputGroupBy, inputAggregate,
-                                          mask, numBuckets, buckets, result);
+            groupBySortAuxAgg<Aggregator, true>(0, partitions[0], inputGroupBy, inputAggregate,
+                                                minimum, passes, result);
         }
         for (i = 1; i < numBuckets; i++) {
             if (partitions[i] > partitions[i - 1]) {
-                groupBySortAuxAgg<Aggregator>(partitions[i - 1], partitions[i], inputGroupBy,
-                                              inputAggregate, mask, numBuckets, buckets, result);
+                groupBySortAuxAgg<Aggregator, true>(partitions[i - 1], partitions[i], inputGroupBy,
+                                                    inputAggregate, minimum, passes, result);
             }
         }
     }
 
-    std::swap(inputGroupBy, bufferGroupBy);
-    std::swap(inputAggregate, bufferAggregate);
-
-    delete[]bufferGroupBy;
-    delete[]bufferAggregate;
-
-    return result;
+    arena.rewind(arenaMark);
 }
 
-template<template<typename> class Aggregator, typename T1, typename T2>
-vectorOfPairs<T1, T2> groupByAdaptive(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality) {
-    static_assert(std::is_integral<T1>::value, "GroupBy column must be an integer type");
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void groupByAdaptiveInto(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality, Output &result) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
     static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
 
-    constexpr int tuplesPerChunk = 75 * 1000;
-    constexpr int tuplesBetweenHashing = 2*1000*1000;
+    const GroupByAdaptiveParameters &parameters = getGroupByAdaptiveParameters();
+    int tuplesPerChunk = parameters.tuplesPerChunk;
+    int tuplesBetweenHashing = parameters.tuplesBetweenHashing;
     int initialSize = std::max(static_cast<int>(2.5 * cardinality), 400000);
 
-    tsl::robin_map<T1, T2> map(initialSize);
-    typename tsl::robin_map<T1, T2>::iterator it;
+    groupByHashMap<T1, T2> map(initialSize);
+    typename groupByHashMap<T1, T2>::iterator it;
 
     std::vector<std::string> counters = {"PERF_COUNT_HW_CACHE_MISSES"};
     long_long *counterValues = Counters::getInstance().getEvents(counters);
 
     int hashTableEntryBytes = sizeof(T1) + sizeof(T2);
-    float tuplesPerLastLevelCacheMissThreshold = (GROUPBY_MACHINE_CONSTANT * bytesPerCacheLine()) / hashTableEntryBytes;
+    float tuplesPerLastLevelCacheMissThreshold =
+            (parameters.machineConstant * bytesPerCacheLine()) / hashTableEntryBytes;
 
     int index = 0;
     int tuplesToProcess;
 
+    // The range of the first chunk is a lower bound on the range of the input, so the full min / max pass is only
+    // paid for when the sample suggests the keys fit a dense array
+    if (n > 0) {
+        T1 smallest = inputGroupBy[0];
+        T1 largest = inputGroupBy[0];
+        keyRange(std::min(tuplesPerChunk, n), inputGroupBy, smallest, largest);
+        if (denseKeyDomain(n, smallest, largest)) {
+            keyRange(n, inputGroupBy, smallest, largest);
+            if (denseKeyDomain(n, smallest, largest)) {
+                groupByDenseAux<Aggregator>(n, inputGroupBy, inputAggregate, smallest, largest, result);
+                return;
+            }
+        }
+    }
+
     vectorOfPairs<int, int> sectionsToBeSorted;
     int elements = 0;
 
-    vectorOfPairs<T1, T2> result;
+    if (groupBySortFromStart(cardinality, hashTableEntryBytes)) {
+        tuplesToProcess = std::min(tuplesBetweenHashing, n);
+        sectionsToBeSorted.emplace_back(0, tuplesToProcess);
+        index += tuplesToProcess;
+        elements += tuplesToProcess;
+    }
+
+    T1 mapSmallest = std::numeric_limits<T1>::max();
     T1 mapLargest = std::numeric_limits<T1>::lowest();
 
+    // Once the sections waiting to be sorted exceed the backlog budget they are sorted together with the hash table and
+    // the previous merged run into a new run of partial aggregates in key order. The emptied table then only holds keys
+    // seen since, so hashing is cheap to re-probe when the key distribution changes.
+    int backlogTuples = std::max(static_cast<int>(GROUPBY_ADAPTIVE_BACKLOG_BYTES / hashTableEntryBytes),
+                                 tuplesBetweenHashing);
+    vectorOfPairs<T1, T2> mergedRun;
+    vectorOfPairs<T1, T2> nextMergedRun;
+
     while (index < n) {
 
         tuplesToProcess = std::min(tuplesPerChunk, n - index);
 
         Counters::getInstance().readEventSet();
 
-        groupByAdaptiveAuxHash<Aggregator>(tuplesToProcess, inputGroupBy, inputAggregate, map, index, mapLargest);
+        groupByAdaptiveAuxHash<Aggregator>(tuplesToProcess, inputGroupBy, inputAggregate, map, index, mapSmallest,
+                                           mapLargest);
 
         Counters::getInstance().readEventSet();
 
@@ -346,29 +873,1279 @@ vectorOfPairs<T1, T2> groupByAdaptive(int n, T1 *inputGroupBy, T2 *inputAggregat
             index += tuplesToProcess;
             elements += tuplesToProcess;
         }
+
+        if (elements >= backlogTuples && index < n) {
+            elements += map.size() + mergedRun.size();
+            groupByAdaptiveAuxSort<Aggregator>(elements, inputGroupBy, inputAggregate, sectionsToBeSorted, map,
+                                               mergedRun, mapSmallest, mapLargest, nextMergedRun);
+            mergedRun.swap(nextMergedRun);
+            nextMergedRun.clear();
+            sectionsToBeSorted.clear();
+            map.clear();
+            mapSmallest = std::numeric_limits<T1>::max();
+            mapLargest = std::numeric_limits<T1>::lowest();
+            elements = 0;
+        }
     }
 
-    if (sectionsToBeSorted.empty()) {
-        return {map.begin(), map.end()};
+    if (sectionsToBeSorted.empty() && mergedRun.empty()) {
+        writeGroupByMap(map, result);
+        return;
     }
-    elements += map.size();
-    return groupByAdaptiveAuxSort<Aggregator>(elements, inputGroupBy, inputAggregate, sectionsToBeSorted,
-                                              map, mapLargest, result);
+    elements += map.size() + mergedRun.size();
+    groupByAdaptiveAuxSort<Aggregator>(elements, inputGroupBy, inputAggregate, sectionsToBeSorted, map, mergedRun,
+                                       mapSmallest, mapLargest, result);
 }
 
 template<template<typename> class Aggregator, typename T1, typename T2>
-vectorOfPairs<T1, T2> runGroupByFunction(GroupBy groupByImplementation, int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality) {
-    switch (groupByImplementation) {
-        case GroupBy::Hash:
-            return groupByHash<Aggregator>(n, inputGroupBy, inputAggregate, cardinality);
-        case GroupBy::Sort:
-            return groupBySort<Aggregator>(n, inputGroupBy, inputAggregate);
-        case GroupBy::Adaptive:
-            return groupByAdaptive<Aggregator>(n, inputGroupBy, inputAggregate, cardinality);
-        default:
-            std::cout << "Invalid selection of 'GroupBy' implementation!" << std::endl;
-            exit(1);
+vectorOfPairs<T1, T2> groupByHash(int n, T1 *inputGroupBy, T2 *inputAggregate) {
+    return groupByHash<Aggregator>(n, inputGroupBy, inputAggregate, estimateCardinality(n, inputGroupBy));
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByAdaptive(int n, T1 *inputGroupBy, T2 *inputAggregate) {
+    return groupByAdaptive<Aggregator>(n, inputGroupBy, inputAggregate, estimateCardinality(n, inputGroupBy));
+}
+
+// robin_map grows once half of its buckets are used, so a table holding this many entries occupies the given fraction
+// of the last level cache
+inline int groupByHybridTableEntries(int hashTableEntryBytes) {
+    return std::max(static_cast<int>(GROUPBY_HYBRID_LLC_FRACTION * l3cacheSize() / (2 * hashTableEntryBytes)), 1024);
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+inline void groupByHybridAux(int n, const T1 *inputGroupBy, const T2 *inputAggregate, groupByHashMap<T1, T2> &map,
+                             int maxEntries, T1 *&overflowGroupBy, T2 *&overflowAggregate, int &overflow,
+                             int totalTuples, T1 &smallest, T1 &largest, int &index) {
+    typename groupByHashMap<T1, T2>::iterator it;
+    int startingIndex = index;
+    for (; index < startingIndex + n; ++index) {
+        it = map.find(inputGroupBy[index]);
+        if (it != map.end()) {
+            it.value() = Aggregator<T2>()(it->second, inputAggregate[index], false);
+        } else if (static_cast<int>(map.size()) < maxEntries) {
+            map.insert({inputGroupBy[index], Aggregator<T2>()(0, inputAggregate[index], true)});
+        } else {
+            // Every tuple adds at most one overflow entry, either directly or through the table entry it created
+            if (overflowGroupBy == nullptr) {
+                overflowGroupBy = MemoryArena::getInstance().allocate<T1>(totalTuples);
+                overflowAggregate = MemoryArena::getInstance().allocate<T2>(totalTuples);
+            }
+            overflowGroupBy[overflow] = inputGroupBy[index];
+            overflowAggregate[overflow++] = Aggregator<T2>::init(inputAggregate[index]);
+            smallest = std::min(smallest, inputGroupBy[index]);
+            largest = std::max(largest, inputGroupBy[index]);
+        }
+    }
+}
+
+template<typename T1, typename T2>
+inline void groupByHybridFlush(groupByHashMap<T1, T2> &map, T1 *&overflowGroupBy, T2 *&overflowAggregate,
+                               int &overflow, int totalTuples, T1 &smallest, T1 &largest) {
+    if (overflowGroupBy == nullptr) {
+        overflowGroupBy = MemoryArena::getInstance().allocate<T1>(totalTuples);
+        overflowAggregate = MemoryArena::getInstance().allocate<T2>(totalTuples);
+    }
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        overflowGroupBy[overflow] = it->first;
+        overflowAggregate[overflow++] = it->second;
+        smallest = std::min(smallest, it->first);
+        largest = std::max(largest, it->first);
+    }
+    map.clear();
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void groupByHybridInto(int n, T1 *inputGroupBy, T2 *inputAggregate, Output &result) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
+
+    int tuplesPerChunk = getGroupByAdaptiveParameters().tuplesPerChunk;
+    int maxEntries = groupByHybridTableEntries(sizeof(T1) + sizeof(T2));
+
+    groupByHashMap<T1, T2> map(2 * maxEntries);
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *overflowGroupBy = nullptr;
+    T2 *overflowAggregate = nullptr;
+    int overflow = 0;
+    T1 smallest = std::numeric_limits<T1>::max();
+    T1 largest = std::numeric_limits<T1>::lowest();
+
+    int index = 0;
+    int tuplesToProcess;
+    int overflowBeforeChunk;
+
+    while (index < n) {
+        tuplesToProcess = std::min(tuplesPerChunk, n - index);
+        overflowBeforeChunk = overflow;
+
+        groupByHybridAux<Aggregator>(tuplesToProcess, inputGroupBy, inputAggregate, map, maxEntries, overflowGroupBy,
+                                     overflowAggregate, overflow, n, smallest, largest, index);
+
+        // A full table that most of the chunk missed holds keys that are no longer frequent, so it is moved to the
+        // overflow to make room for the keys of the following chunks
+        if (overflow - overflowBeforeChunk > tuplesToProcess / 2) {
+            groupByHybridFlush(map, overflowGroupBy, overflowAggregate, overflow, n, smallest, largest);
+        }
+    }
+
+    if (overflow == 0) {
+        writeGroupByMap(map, result);
+        return;
+    }
+
+    groupByHybridFlush(map, overflowGroupBy, overflowAggregate, overflow, n, smallest, largest);
+
+    RadixPasses passes = radixPasses(smallest, largest, sizeof(T2) + sizeof(bool));
+    T1 *bufferGroupBy = arena.allocate<T1>(overflow);
+    T2 *bufferAggregate = arena.allocate<T2>(overflow);
+
+    groupBySortAux<Aggregator, true>(0, overflow, overflowGroupBy, overflowAggregate, bufferGroupBy, bufferAggregate,
+                                     smallest, passes, passes.count - 1, result);
+
+    arena.rewind(arenaMark);
+}
+
+template<typename T1, typename T2>
+inline void groupBySpillWriteBlock(std::FILE *file, const T1 *blockGroupBy, const T2 *blockAggregate, int count) {
+    if (std::fwrite(blockGroupBy, sizeof(T1), count, file) != static_cast<size_t>(count) ||
+        std::fwrite(blockAggregate, sizeof(T2), count, file) != static_cast<size_t>(count)) {
+        std::cout << "Failed to write a group by partition to disk!" << std::endl;
+        exit(1);
+    }
+}
+
+template<typename T1, typename T2>
+inline void groupBySpillReadBlock(std::FILE *file, T1 *blockGroupBy, T2 *blockAggregate, int count) {
+    if (std::fread(blockGroupBy, sizeof(T1), count, file) != static_cast<size_t>(count) ||
+        std::fread(blockAggregate, sizeof(T2), count, file) != static_cast<size_t>(count)) {
+        std::cout << "Failed to read a group by partition from disk!" << std::endl;
+        exit(1);
+    }
+}
+
+// Each level re-mixes the hash of the level above, so that a partition re-spilled at the next level splits on bits
+// that did not select it. Both steps are bijections, so distinct keys keep distinct hashes at every level.
+template<typename T>
+inline int groupBySpillPartition(T key, int level, int bits) {
+    auto fold = static_cast<typename RadixKey<T>::type>(key);
+    if constexpr (sizeof(T) > sizeof(uint64_t)) {
+        fold ^= fold >> 64;
+    }
+    uint64_t hash = static_cast<uint64_t>(fold) * PARTITION_HASH_MULTIPLIER;
+    for (int i = 0; i < level; i++) {
+        hash = (hash ^ (hash >> 29)) * PARTITION_HASH_MULTIPLIER;
+    }
+    return static_cast<int>(hash >> (64 - bits));
+}
+
+// A partition's hash table is reserved for one entry per tuple. A robin_map bucket holds the pair and its distance from
+// the ideal bucket, and a maximum load factor of one half rounded up to a power of two gives at most four buckets per
+// reserved entry.
+template<typename T1, typename T2>
+constexpr long groupBySpillTableBytesPerTuple() {
+    return 4 * static_cast<long>(sizeof(std::pair<T1, T2>) +
+                                 std::max(alignof(std::pair<T1, T2>), sizeof(int16_t)));
+}
+
+// Partitions n tuples, read from inputGroupBy and inputAggregate or, below the first level, from file in blocks of
+// fileBlockTuples as its parent wrote them, into temporary files by the hash of their key. A partition whose hash table
+// fits in half the budget, or in a write block for budgets too small to re-spill into efficiently, is aggregated in a
+// table reserved for its tuples, and one that does not is re-spilled at the next level. A partition that received every
+// tuple of its parent is aggregated in a table left to grow, as a fresh hash could not split its keys and so there are
+// almost surely very few of them.
+template<template<typename> class Aggregator, typename T1, typename T2>
+void groupBySpillAux(int n, const T1 *inputGroupBy, const T2 *inputAggregate, std::FILE *file, int fileBlockTuples,
+                     int level, long memoryBudgetBytes, vectorOfPairs<T1, T2> &result) {
+    long bytesPerTuple = sizeof(T1) + sizeof(T2);
+    long tableBytesPerTuple = groupBySpillTableBytesPerTuple<T1, T2>();
+
+    // The table of the expected partition takes a quarter of the budget, leaving room for the variance of the hash.
+    // The other half of the budget holds one write block per partition.
+    int partitionBits = 1;
+    while (partitionBits < GROUPBY_SPILL_MAX_PARTITION_BITS &&
+           ((n * tableBytesPerTuple) >> partitionBits) > memoryBudgetBytes / 4) {
+        partitionBits++;
+    }
+    int numPartitions = 1 << partitionBits;
+    int blockTuples = static_cast<int>(std::max(
+            std::min(GROUPBY_SPILL_BLOCK_BYTES, memoryBudgetBytes / (2 * numPartitions)) / bytesPerTuple, 1L));
+
+    T1 *blockGroupBy = new T1[static_cast<long>(numPartitions) * blockTuples];
+    T2 *blockAggregate = new T2[static_cast<long>(numPartitions) * blockTuples];
+    T1 *readGroupBy = file != nullptr ? new T1[fileBlockTuples] : nullptr;
+    T2 *readAggregate = file != nullptr ? new T2[fileBlockTuples] : nullptr;
+    std::vector<int> blockFill(numPartitions, 0);
+    std::vector<int> partitionSizes(numPartitions, 0);
+    std::vector<std::FILE *> partitionFiles(numPartitions);
+    for (auto &partitionFile : partitionFiles) {
+        partitionFile = std::tmpfile();
+        if (partitionFile == nullptr) {
+            std::cout << "Failed to create a temporary file for a group by partition!" << std::endl;
+            exit(1);
+        }
+    }
+
+    int i;
+    int j;
+    int partition;
+    long position;
+    int tuplesToRead;
+    const T1 *scatterGroupBy;
+    const T2 *scatterAggregate;
+    for (i = 0; i < n; i += tuplesToRead) {
+        if (file != nullptr) {
+            tuplesToRead = std::min(fileBlockTuples, n - i);
+            groupBySpillReadBlock(file, readGroupBy, readAggregate, tuplesToRead);
+            scatterGroupBy = readGroupBy;
+            scatterAggregate = readAggregate;
+        } else {
+            tuplesToRead = n;
+            scatterGroupBy = inputGroupBy;
+            scatterAggregate = inputAggregate;
+        }
+        for (j = 0; j < tuplesToRead; j++) {
+            partition = groupBySpillPartition(scatterGroupBy[j], level, partitionBits);
+            position = static_cast<long>(partition) * blockTuples + blockFill[partition];
+            blockGroupBy[position] = scatterGroupBy[j];
+            blockAggregate[position] = scatterAggregate[j];
+            if (++blockFill[partition] == blockTuples) {
+                groupBySpillWriteBlock(partitionFiles[partition], blockGroupBy + position - (blockTuples - 1),
+                                       blockAggregate + position - (blockTuples - 1), blockTuples);
+                partitionSizes[partition] += blockTuples;
+                blockFill[partition] = 0;
+            }
+        }
+    }
+    for (partition = 0; partition < numPartitions; partition++) {
+        position = static_cast<long>(partition) * blockTuples;
+        groupBySpillWriteBlock(partitionFiles[partition], blockGroupBy + position, blockAggregate + position,
+                               blockFill[partition]);
+        partitionSizes[partition] += blockFill[partition];
+    }
+
+    // Only the read block is kept while partitions are aggregated, so that the write blocks of the levels below do not
+    // add up with these
+    delete[]blockGroupBy;
+    delete[]blockAggregate;
+    delete[]readGroupBy;
+    delete[]readAggregate;
+
+    T1 *aggregateGroupBy;
+    T2 *aggregateAggregate;
+    int index;
+    bool fitsInBudget;
+    for (partition = 0; partition < numPartitions; partition++) {
+        std::rewind(partitionFiles[partition]);
+        fitsInBudget = partitionSizes[partition] * tableBytesPerTuple <=
+                       std::max(memoryBudgetBytes / 2, GROUPBY_SPILL_BLOCK_BYTES);
+        if (!fitsInBudget && partitionSizes[partition] < n) {
+            groupBySpillAux<Aggregator>(partitionSizes[partition], static_cast<const T1 *>(nullptr),
+                                        static_cast<const T2 *>(nullptr), partitionFiles[partition], blockTuples,
+                                        level + 1, memoryBudgetBytes, result);
+        } else {
+            groupByHashMap<T1, T2> map(fitsInBudget ? partitionSizes[partition] : 0);
+            aggregateGroupBy = new T1[blockTuples];
+            aggregateAggregate = new T2[blockTuples];
+            for (i = 0; i < partitionSizes[partition]; i += tuplesToRead) {
+                tuplesToRead = std::min(blockTuples, partitionSizes[partition] - i);
+                groupBySpillReadBlock(partitionFiles[partition], aggregateGroupBy, aggregateAggregate, tuplesToRead);
+                index = 0;
+                groupByHashAux<Aggregator>(tuplesToRead, aggregateGroupBy, aggregateAggregate, map, index);
+            }
+            result.insert(result.end(), map.begin(), map.end());
+            delete[]aggregateGroupBy;
+            delete[]aggregateAggregate;
+        }
+        std::fclose(partitionFiles[partition]);
+    }
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupBySpill(int n, T1 *inputGroupBy, T2 *inputAggregate, long memoryBudgetBytes) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
+
+    long bytesPerTuple = sizeof(T1) + sizeof(T2);
+    if (n == 0 || n * bytesPerTuple <= memoryBudgetBytes) {
+        return groupBySort<Aggregator>(n, inputGroupBy, inputAggregate);
+    }
+
+    vectorOfPairs<T1, T2> result;
+    groupBySpillAux<Aggregator>(n, static_cast<const T1 *>(inputGroupBy), static_cast<const T2 *>(inputAggregate),
+                                nullptr, 0, 0, memoryBudgetBytes, result);
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2, typename Output>
+void runGroupByFunctionInto(GroupBy groupByImplementation, int n, T1 *inputGroupBy, T2 *inputAggregate,
+                            int cardinality, Output &result) {
+    switch (groupByImplementation) {
+        case GroupBy::Hash:
+            groupByHashInto<Aggregator>(n, inputGroupBy, inputAggregate, cardinality, result);
+            break;
+        case GroupBy::Sort:
+            groupBySortInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+            break;
+        case GroupBy::Dense:
+            groupByDenseInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+            break;
+        case GroupBy::Hybrid:
+            groupByHybridInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+            break;
+        case GroupBy::Adaptive:
+            groupByAdaptiveInto<Aggregator>(n, inputGroupBy, inputAggregate, cardinality, result);
+            break;
+        default:
+            std::cout << "Invalid selection of 'GroupBy' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByHash(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality) {
+    vectorOfPairs<T1, T2> result;
+    groupByHashInto<Aggregator>(n, inputGroupBy, inputAggregate, cardinality, result);
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupBySort(int n, T1 *inputGroupBy, T2 *inputAggregate) {
+    vectorOfPairs<T1, T2> result;
+    groupBySortInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByDense(int n, T1 *inputGroupBy, T2 *inputAggregate) {
+    vectorOfPairs<T1, T2> result;
+    groupByDenseInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByHybrid(int n, T1 *inputGroupBy, T2 *inputAggregate) {
+    vectorOfPairs<T1, T2> result;
+    groupByHybridInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> groupByAdaptive(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality) {
+    vectorOfPairs<T1, T2> result;
+    groupByAdaptiveInto<Aggregator>(n, inputGroupBy, inputAggregate, cardinality, result);
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> runGroupByFunction(GroupBy groupByImplementation, int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality) {
+    vectorOfPairs<T1, T2> result;
+    runGroupByFunctionInto<Aggregator>(groupByImplementation, n, inputGroupBy, inputAggregate, cardinality, result);
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupByHash(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality, T1 *outputGroupBy,
+                T2 *outputAggregate) {
+    ColumnarGroupByOutput<T1, T2> result{outputGroupBy, outputAggregate, 0};
+    groupByHashInto<Aggregator>(n, inputGroupBy, inputAggregate, cardinality, result);
+    return static_cast<int>(result.size());
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupBySort(int n, T1 *inputGroupBy, T2 *inputAggregate, T1 *outputGroupBy, T2 *outputAggregate) {
+    ColumnarGroupByOutput<T1, T2> result{outputGroupBy, outputAggregate, 0};
+    groupBySortInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+    return static_cast<int>(result.size());
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupByDense(int n, T1 *inputGroupBy, T2 *inputAggregate, T1 *outputGroupBy, T2 *outputAggregate) {
+    ColumnarGroupByOutput<T1, T2> result{outputGroupBy, outputAggregate, 0};
+    groupByDenseInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+    return static_cast<int>(result.size());
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupByHybrid(int n, T1 *inputGroupBy, T2 *inputAggregate, T1 *outputGroupBy, T2 *outputAggregate) {
+    ColumnarGroupByOutput<T1, T2> result{outputGroupBy, outputAggregate, 0};
+    groupByHybridInto<Aggregator>(n, inputGroupBy, inputAggregate, result);
+    return static_cast<int>(result.size());
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int groupByAdaptive(int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality, T1 *outputGroupBy,
+                    T2 *outputAggregate) {
+    ColumnarGroupByOutput<T1, T2> result{outputGroupBy, outputAggregate, 0};
+    groupByAdaptiveInto<Aggregator>(n, inputGroupBy, inputAggregate, cardinality, result);
+    return static_cast<int>(result.size());
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int runGroupByFunction(GroupBy groupByImplementation, int n, T1 *inputGroupBy, T2 *inputAggregate, int cardinality,
+                       T1 *outputGroupBy, T2 *outputAggregate) {
+    ColumnarGroupByOutput<T1, T2> result{outputGroupBy, outputAggregate, 0};
+    runGroupByFunctionInto<Aggregator>(groupByImplementation, n, inputGroupBy, inputAggregate, cardinality, result);
+    return static_cast<int>(result.size());
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> runGroupByFunction(GroupBy groupByImplementation, int n, T1 *inputGroupBy, T2 *inputAggregate) {
+    int cardinality = 0;
+    if (groupByImplementation == GroupBy::Hash || groupByImplementation == GroupBy::Adaptive) {
+        cardinality = estimateCardinality(n, inputGroupBy);
+    }
+    return runGroupByFunction<Aggregator>(groupByImplementation, n, inputGroupBy, inputAggregate, cardinality);
+}
+
+template<size_t N>
+struct CompositeKeyLayout {
+    std::array<uint64_t, N> minimums;
+    std::array<int, N> shifts;
+    int totalBits;
+};
+
+template<typename T>
+inline uint64_t compositeKeyOffset(T value, uint64_t minimum) {
+    return static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(value) -
+                                 static_cast<std::make_unsigned_t<T>>(minimum));
+}
+
+template<typename T>
+inline T compositeKeyValue(uint64_t offset, uint64_t minimum) {
+    return static_cast<T>(static_cast<std::make_unsigned_t<T>>(minimum) +
+                          static_cast<std::make_unsigned_t<T>>(offset));
+}
+
+template<typename T>
+inline void compositeKeyColumnRange(int n, const T *input, uint64_t &minimum, int &bits) {
+    T smallest = n > 0 ? input[0] : 0;
+    T largest = smallest;
+    for (int i = 1; i < n; ++i) {
+        smallest = std::min(smallest, input[i]);
+        largest = std::max(largest, input[i]);
+    }
+    minimum = static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(smallest));
+    uint64_t range = compositeKeyOffset(largest, minimum);
+    bits = 0;
+    while (range != 0) {
+        range >>= 1;
+        bits++;
+    }
+}
+
+template<typename... KeyTypes, size_t... I>
+CompositeKeyLayout<sizeof...(KeyTypes)> computeCompositeKeyLayout(int n, const std::tuple<KeyTypes *...> &inputGroupBy,
+                                                                  std::index_sequence<I...>) {
+    constexpr size_t numKeys = sizeof...(KeyTypes);
+    CompositeKeyLayout<numKeys> layout{};
+    std::array<int, numKeys> bits{};
+    (compositeKeyColumnRange(n, std::get<I>(inputGroupBy), layout.minimums[I], bits[I]), ...);
+
+    layout.totalBits = 0;
+    for (int i = static_cast<int>(numKeys) - 1; i >= 0; --i) {
+        layout.shifts[i] = layout.totalBits;
+        layout.totalBits += bits[i];
+    }
+    return layout;
+}
+
+template<typename P, typename... KeyTypes, size_t... I>
+void packCompositeKeys(int n, const std::tuple<KeyTypes *...> &inputGroupBy,
+                       const CompositeKeyLayout<sizeof...(KeyTypes)> &layout, P *packedGroupBy,
+                       std::index_sequence<I...>) {
+    for (int i = 0; i < n; ++i) {
+        packedGroupBy[i] = (... | (static_cast<P>(compositeKeyOffset(std::get<I>(inputGroupBy)[i],
+                                                                     layout.minimums[I])) << layout.shifts[I]));
+    }
+}
+
+template<typename P, typename... KeyTypes, size_t... I>
+inline std::tuple<KeyTypes...> unpackCompositeKey(P packedKey, const CompositeKeyLayout<sizeof...(KeyTypes)> &layout,
+                                                  std::index_sequence<I...>) {
+    auto column = [&](size_t i) {
+        int bits = (i == 0 ? layout.totalBits : layout.shifts[i - 1]) - layout.shifts[i];
+        P mask = bits == 0 ? 0 : (~static_cast<P>(0) >> (8 * sizeof(P) - bits));
+        return static_cast<uint64_t>((packedKey >> layout.shifts[i]) & mask);
+    };
+    return {compositeKeyValue<KeyTypes>(column(I), layout.minimums[I])...};
+}
+
+template<template<typename> class Aggregator, typename P, typename T2, typename... KeyTypes>
+vectorOfPairs<std::tuple<KeyTypes...>, T2> groupByPackedCompositeKey(GroupBy groupByImplementation, int n,
+                                                                     const std::tuple<KeyTypes *...> &inputGroupBy,
+                                                                     T2 *inputAggregate, int cardinality,
+                                                                     const CompositeKeyLayout<sizeof...(KeyTypes)>
+                                                                             &layout) {
+    P *packedGroupBy = new P[n];
+    packCompositeKeys(n, inputGroupBy, layout, packedGroupBy, std::index_sequence_for<KeyTypes...>{});
+
+    // The radix implementations use their input arrays as scratch space, which would leave the payload out of step
+    // with the caller's (unpacked) key columns
+    T2 *packedAggregate = inputAggregate;
+    if (groupByImplementation != GroupBy::Hash) {
+        packedAggregate = new T2[n];
+        std::copy(inputAggregate, inputAggregate + n, packedAggregate);
+    }
+
+    auto packedResult = runGroupByFunction<Aggregator>(groupByImplementation, n, packedGroupBy, packedAggregate,
+                                                       cardinality);
+    delete[]packedGroupBy;
+    if (packedAggregate != inputAggregate) {
+        delete[]packedAggregate;
+    }
+
+    vectorOfPairs<std::tuple<KeyTypes...>, T2> result;
+    result.reserve(packedResult.size());
+    for (const auto &group : packedResult) {
+        result.emplace_back(unpackCompositeKey<P, KeyTypes...>(group.first, layout,
+                                                               std::index_sequence_for<KeyTypes...>{}),
+                            group.second);
+    }
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T2, typename... KeyTypes, size_t... I>
+vectorOfPairs<std::tuple<KeyTypes...>, T2> groupByWideCompositeKey(int n,
+                                                                   const std::tuple<KeyTypes *...> &inputGroupBy,
+                                                                   T2 *inputAggregate, int cardinality,
+                                                                   const CompositeKeyLayout<sizeof...(KeyTypes)>
+                                                                           &layout,
+                                                                   std::index_sequence<I...>) {
+    using WideKey = std::array<uint64_t, sizeof...(KeyTypes)>;
+
+    WideKey *wideGroupBy = new WideKey[n];
+    for (int i = 0; i < n; ++i) {
+        wideGroupBy[i] = {compositeKeyOffset(std::get<I>(inputGroupBy)[i], layout.minimums[I])...};
+    }
+
+    groupByHashMap<WideKey, T2> map(std::max(static_cast<int>(2.5 * cardinality), 400000));
+    int index = 0;
+    groupByHashAux<Aggregator>(n, wideGroupBy, inputAggregate, map, index);
+    delete[]wideGroupBy;
+
+    vectorOfPairs<std::tuple<KeyTypes...>, T2> result;
+    result.reserve(map.size());
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        result.emplace_back(std::tuple<KeyTypes...>{compositeKeyValue<KeyTypes>(it->first[I],
+                                                                                 layout.minimums[I])...},
+                            it->second);
+    }
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T2, typename... KeyTypes>
+vectorOfPairs<std::tuple<KeyTypes...>, T2> groupByCompositeKey(GroupBy groupByImplementation, int n,
+                                                               std::tuple<KeyTypes *...> inputGroupBy,
+                                                               T2 *inputAggregate, int cardinality) {
+    static_assert(sizeof...(KeyTypes) >= 2 && sizeof...(KeyTypes) <= 4, "Composite keys must have 2-4 columns");
+    static_assert((std::is_integral<KeyTypes>::value && ...), "GroupBy columns must be integer types");
+    static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
+
+    auto layout = computeCompositeKeyLayout(n, inputGroupBy, std::index_sequence_for<KeyTypes...>{});
+
+    if (layout.totalBits <= 64) {
+        return groupByPackedCompositeKey<Aggregator, uint64_t>(groupByImplementation, n, inputGroupBy,
+                                                               inputAggregate, cardinality, layout);
+    }
+    if (layout.totalBits <= 128) {
+        return groupByPackedCompositeKey<Aggregator, unsigned __int128>(groupByImplementation, n, inputGroupBy,
+                                                                        inputAggregate, cardinality, layout);
+    }
+    return groupByWideCompositeKey<Aggregator>(n, inputGroupBy, inputAggregate, cardinality, layout,
+                                               std::index_sequence_for<KeyTypes...>{});
+}
+
+template<template<typename> class Aggregator, typename T>
+AggregateColumn<Aggregator, T> aggregateColumn(T *input) {
+    return {input};
+}
+
+template<typename... AggregateColumns>
+using multiAggregateState = std::tuple<std::vector<typename AggregateColumns::StateType>...>;
+
+template<typename... AggregateColumns>
+using multiAggregateValuePointers = std::tuple<typename AggregateColumns::ValueType *...>;
+
+template<typename... AggregateColumns>
+using multiAggregateStatePointers = std::tuple<typename AggregateColumns::StateType *...>;
+
+template<bool mergePartials, typename... AggregateColumns>
+using multiAggregateRadixPointers = std::conditional_t<mergePartials,
+                                                       multiAggregateStatePointers<AggregateColumns...>,
+                                                       multiAggregateValuePointers<AggregateColumns...>>;
+
+template<typename... AggregateColumns, size_t... I>
+inline void appendMultiAggregates(multiAggregateState<AggregateColumns...> &aggregates,
+                                  const std::tuple<AggregateColumns...> &aggregateColumns, int index,
+                                  std::index_sequence<I...>) {
+    (std::get<I>(aggregates).push_back(
+            AggregateColumns::AggregatorType::init(std::get<I>(aggregateColumns).input[index])), ...);
+}
+
+template<typename... AggregateColumns, size_t... I>
+inline void updateMultiAggregates(multiAggregateState<AggregateColumns...> &aggregates, int group,
+                                  const std::tuple<AggregateColumns...> &aggregateColumns, int index,
+                                  std::index_sequence<I...>) {
+    (AggregateColumns::AggregatorType::update(std::get<I>(aggregates)[group],
+                                              std::get<I>(aggregateColumns).input[index]), ...);
+}
+
+template<typename T1, typename... AggregateColumns, size_t... I>
+inline void finalizeMultiAggregates(multiAggregateState<AggregateColumns...> &aggregates,
+                                    MultiAggregateResult<T1, typename AggregateColumns::ResultType...> &result,
+                                    std::index_sequence<I...>) {
+    auto finalize = [](auto &states, auto &results, auto column) {
+        using Column = decltype(column);
+        if constexpr (std::is_same<typename Column::StateType, typename Column::ResultType>::value) {
+            results = std::move(states);
+        } else {
+            results.resize(states.size());
+            for (size_t i = 0; i < states.size(); ++i) {
+                results[i] = Column::AggregatorType::finalize(states[i]);
+            }
+        }
+    };
+    (finalize(std::get<I>(aggregates), std::get<I>(result.aggregates), AggregateColumns{}), ...);
+}
+
+template<typename T1, typename... AggregateColumns>
+inline void groupByHashMultiAggregateAux(int n, const T1 *inputGroupBy,
+                                         const std::tuple<AggregateColumns...> &aggregateColumns,
+                                         groupByHashMap<T1, int> &map,
+                                         multiAggregateState<AggregateColumns...> &aggregates, int &index) {
+    typename groupByHashMap<T1, int>::iterator it;
+    int startingIndex = index;
+    for (; index < startingIndex + n; ++index) {
+        it = map.find(inputGroupBy[index]);
+        if (it != map.end()) {
+            updateMultiAggregates(aggregates, it->second, aggregateColumns, index,
+                                  std::index_sequence_for<AggregateColumns...>{});
+        } else {
+            map.insert({inputGroupBy[index], static_cast<int>(map.size())});
+            appendMultiAggregates(aggregates, aggregateColumns, index, std::index_sequence_for<AggregateColumns...>{});
+        }
+    }
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> multiAggregateResultFromMap(
+        groupByHashMap<T1, int> &map, multiAggregateState<AggregateColumns...> &aggregates) {
+    MultiAggregateResult<T1, typename AggregateColumns::ResultType...> result;
+    result.groupBy.resize(map.size());
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        result.groupBy[it->second] = it->first;
+    }
+    finalizeMultiAggregates<T1, AggregateColumns...>(aggregates, result,
+                                                     std::index_sequence_for<AggregateColumns...>{});
+    return result;
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByHashMultiAggregate(
+        int n, T1 *inputGroupBy, int cardinality, AggregateColumns... aggregateColumns) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert((std::is_arithmetic<typename AggregateColumns::ValueType>::value && ...),
+                  "Payload columns must be numeric types");
+
+    groupByHashMap<T1, int> map(std::max(static_cast<int>(2.5 * cardinality), 400000));
+    multiAggregateState<AggregateColumns...> aggregates;
+
+    int index = 0;
+    groupByHashMultiAggregateAux(n, inputGroupBy, std::make_tuple(aggregateColumns...), map, aggregates, index);
+
+    return multiAggregateResultFromMap<T1, AggregateColumns...>(map, aggregates);
+}
+
+template<bool mergePartials, typename T1, typename... AggregateColumns, size_t... I>
+inline void groupBySortMultiAggregateAuxAgg(int start, int end, const T1 *inputGroupBy,
+                                            const multiAggregateRadixPointers<mergePartials, AggregateColumns...>
+                                                    &inputAggregates,
+                                            T1 minimum, const RadixPasses &passes,
+                                            multiAggregateState<AggregateColumns...> &bucketAggregates,
+                                            MultiAggregateResult<T1, typename AggregateColumns::ResultType...> &result,
+                                            std::index_sequence<I...>) {
+    int i;
+    int numBuckets = passes.numBuckets(0);
+    int mask = passes.mask(0);
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    bool *bucketEntryPresent = arena.allocate<bool>(numBuckets);
+    std::fill(bucketEntryPresent, bucketEntryPresent + numBuckets, false);
+
+    for (i = start; i < end; i++) {
+        int bucket = radixBucket(inputGroupBy[i], minimum, 0, mask);
+        if (bucketEntryPresent[bucket]) {
+            if constexpr (mergePartials) {
+                (AggregateColumns::AggregatorType::merge(std::get<I>(bucketAggregates)[bucket],
+                                                         std::get<I>(inputAggregates)[i]), ...);
+            } else {
+                (AggregateColumns::AggregatorType::update(std::get<I>(bucketAggregates)[bucket],
+                                                          std::get<I>(inputAggregates)[i]), ...);
+            }
+        } else {
+            if constexpr (mergePartials) {
+                ((std::get<I>(bucketAggregates)[bucket] = std::get<I>(inputAggregates)[i]), ...);
+            } else {
+                ((std::get<I>(bucketAggregates)[bucket] =
+                        AggregateColumns::AggregatorType::init(std::get<I>(inputAggregates)[i])), ...);
+            }
+            bucketEntryPresent[bucket] = true;
+        }
+    }
+
+    for (i = 0; i < numBuckets; i++) {
+        if (bucketEntryPresent[i]) {
+            result.groupBy.push_back(radixLeafKey(inputGroupBy[start], minimum, mask, i));
+            (std::get<I>(result.aggregates).push_back(
+                    AggregateColumns::AggregatorType::finalize(std::get<I>(bucketAggregates)[i])), ...);
+        }
+    }
+
+    arena.rewind(arenaMark);
+}
+
+template<typename T1, typename... Pointers, size_t... I>
+inline void groupBySortMultiAggregateScatter(int start, int end, const T1 *inputGroupBy,
+                                             const std::tuple<Pointers...> &inputAggregates, T1 *bufferGroupBy,
+                                             const std::tuple<Pointers...> &bufferAggregates, int offset, T1 minimum,
+                                             int shift, int mask, std::vector<int> &buckets,
+                                             std::index_sequence<I...>) {
+    for (int i = end - 1; i >= start; i--) {
+        int position = offset + --buckets[radixBucket(inputGroupBy[i], minimum, shift, mask)];
+        bufferGroupBy[position] = inputGroupBy[i];
+        ((std::get<I>(bufferAggregates)[position] = std::get<I>(inputAggregates)[i]), ...);
+    }
+}
+
+template<bool mergePartials, typename T1, typename... AggregateColumns>
+void groupBySortMultiAggregateAux(int start, int end, T1 *inputGroupBy,
+                                  multiAggregateRadixPointers<mergePartials, AggregateColumns...> inputAggregates,
+                                  T1 *bufferGroupBy,
+                                  multiAggregateRadixPointers<mergePartials, AggregateColumns...> bufferAggregates,
+                                  T1 minimum, const RadixPasses &passes, std::vector<int> &buckets, int pass,
+                                  multiAggregateState<AggregateColumns...> &bucketAggregates,
+                                  MultiAggregateResult<T1, typename AggregateColumns::ResultType...> &result) {
+    int i;
+    int shift = passes.shift[pass];
+    int numBuckets = passes.numBuckets(pass);
+    int mask = passes.mask(pass);
+
+    for (i = start; i < end; i++) {
+        buckets[radixBucket(inputGroupBy[i], minimum, shift, mask)]++;
+    }
+
+    for (i = 1; i < numBuckets; i++) {
+        buckets[i] += buckets[i - 1];
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    int *partitions = arena.allocate<int>(numBuckets);
+    for (i = 0; i < numBuckets; i++) {
+        partitions[i] = buckets[i] + start;
+    }
+
+    groupBySortMultiAggregateScatter(start, end, inputGroupBy, inputAggregates, bufferGroupBy, bufferAggregates,
+                                     start, minimum, shift, mask, buckets,
+                                     std::index_sequence_for<AggregateColumns...>{});
+
+    std::fill(buckets.begin(), buckets.begin() + numBuckets, 0);
+    std::swap(inputGroupBy, bufferGroupBy);
+    std::swap(inputAggregates, bufferAggregates);
+    --pass;
+
+    int partitionStart = start;
+    for (i = 0; i < numBuckets; i++) {
+        if (partitions[i] > partitionStart) {
+            if (pass > 0) {
+                groupBySortMultiAggregateAux<mergePartials, T1, AggregateColumns...>(
+                        partitionStart, partitions[i], inputGroupBy, inputAggregates, bufferGroupBy,
+                        bufferAggregates, minimum, passes, buckets, pass, bucketAggregates, result);
+            } else {
+                groupBySortMultiAggregateAuxAgg<mergePartials, T1, AggregateColumns...>(
+                        partitionStart, partitions[i], inputGroupBy, inputAggregates, minimum, passes,
+                        bucketAggregates, result, std::index_sequence_for<AggregateColumns...>{});
+            }
+        }
+        partitionStart = partitions[i];
+    }
+
+    arena.rewind(arenaMark);
+}
+
+template<typename... Pointers, size_t... I>
+inline void allocateMultiAggregateBuffers(int n, std::tuple<Pointers...> &buffers, std::index_sequence<I...>) {
+    ((std::get<I>(buffers) = MemoryArena::getInstance().allocate<std::remove_pointer_t<Pointers>>(n)), ...);
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupBySortMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert((std::is_arithmetic<typename AggregateColumns::ValueType>::value && ...),
+                  "Payload columns must be numeric types");
+
+    MultiAggregateResult<T1, typename AggregateColumns::ResultType...> result;
+    if (n == 0) {
+        return result;
+    }
+
+    T1 smallest = inputGroupBy[0];
+    T1 largest = inputGroupBy[0];
+    keyRange(n, inputGroupBy, smallest, largest);
+    RadixPasses passes = radixPasses(smallest, largest,
+                                     (sizeof(typename AggregateColumns::StateType) + ... + sizeof(bool)));
+
+    std::vector<int> buckets(passes.maxBuckets, 0);
+    multiAggregateState<AggregateColumns...> bucketAggregates{
+            std::vector<typename AggregateColumns::StateType>(passes.numBuckets(0))...};
+
+    multiAggregateValuePointers<AggregateColumns...> inputAggregates{aggregateColumns.input...};
+    multiAggregateValuePointers<AggregateColumns...> bufferAggregates;
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    allocateMultiAggregateBuffers(n, bufferAggregates, std::index_sequence_for<AggregateColumns...>{});
+    T1 *bufferGroupBy = arena.allocate<T1>(n);
+
+    groupBySortMultiAggregateAux<false, T1, AggregateColumns...>(0, n, inputGroupBy, inputAggregates,
+                                                                 bufferGroupBy, bufferAggregates, smallest,
+                                                                 passes, buckets, passes.count - 1,
+                                                                 bucketAggregates, result);
+
+    arena.rewind(arenaMark);
+
+    return result;
+}
+
+template<typename T1, typename... AggregateColumns, size_t... I>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByDenseMultiAggregateAux(
+        int n, const T1 *inputGroupBy, T1 smallest, T1 largest,
+        const std::tuple<AggregateColumns...> &aggregateColumns, std::index_sequence<I...>) {
+    int i;
+    int offset;
+    int domainSize = static_cast<int>(radixOffset(largest, smallest)) + 1;
+    multiAggregateState<AggregateColumns...> aggregates{
+            std::vector<typename AggregateColumns::StateType>(domainSize)...};
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    bool *entryPresent = arena.allocate<bool>(domainSize);
+    std::fill(entryPresent, entryPresent + domainSize, false);
+
+    for (i = 0; i < n; i++) {
+        offset = static_cast<int>(radixOffset(inputGroupBy[i], smallest));
+        if (entryPresent[offset]) {
+            (AggregateColumns::AggregatorType::update(std::get<I>(aggregates)[offset],
+                                                      std::get<I>(aggregateColumns).input[i]), ...);
+        } else {
+            ((std::get<I>(aggregates)[offset] =
+                    AggregateColumns::AggregatorType::init(std::get<I>(aggregateColumns).input[i])), ...);
+            entryPresent[offset] = true;
+        }
+    }
+
+    MultiAggregateResult<T1, typename AggregateColumns::ResultType...> result;
+    for (i = 0; i < domainSize; i++) {
+        if (entryPresent[i]) {
+            result.groupBy.push_back(denseKey(i, smallest));
+            (std::get<I>(result.aggregates).push_back(
+                    AggregateColumns::AggregatorType::finalize(std::get<I>(aggregates)[i])), ...);
+        }
+    }
+
+    arena.rewind(arenaMark);
+
+    return result;
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByDenseMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert((std::is_arithmetic<typename AggregateColumns::ValueType>::value && ...),
+                  "Payload columns must be numeric types");
+
+    if (n == 0) {
+        return {};
+    }
+
+    T1 smallest = inputGroupBy[0];
+    T1 largest = inputGroupBy[0];
+    keyRange(n, inputGroupBy, smallest, largest);
+
+    if (!denseKeyDomain(n, smallest, largest)) {
+        return groupBySortMultiAggregate(n, inputGroupBy, aggregateColumns...);
+    }
+    return groupByDenseMultiAggregateAux<T1, AggregateColumns...>(n, inputGroupBy, smallest, largest,
+                                                                  std::make_tuple(aggregateColumns...),
+                                                                  std::index_sequence_for<AggregateColumns...>{});
+}
+
+template<typename T1, typename... AggregateColumns, size_t... I>
+inline void groupByAdaptiveMultiAggregateScatter(const vectorOfPairs<int, int> &sectionsToBeSorted,
+                                                 const T1 *inputGroupBy,
+                                                 const std::tuple<AggregateColumns...> &aggregateColumns,
+                                                 const groupByHashMap<T1, int> &map,
+                                                 const multiAggregateState<AggregateColumns...> &mapAggregates,
+                                                 T1 *bufferGroupBy,
+                                                 const multiAggregateStatePointers<AggregateColumns...>
+                                                         &bufferAggregates,
+                                                 T1 minimum, int shift, int mask, std::vector<int> &buckets,
+                                                 std::index_sequence<I...>) {
+    int i;
+    int position;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        position = --buckets[radixBucket(it->first, minimum, shift, mask)];
+        bufferGroupBy[position] = it->first;
+        ((std::get<I>(bufferAggregates)[position] = std::get<I>(mapAggregates)[it->second]), ...);
+    }
+    for (auto section = sectionsToBeSorted.rbegin(); section != sectionsToBeSorted.rend(); ++section) {
+        for (i = section->second - 1; i >= section->first; i--) {
+            position = --buckets[radixBucket(inputGroupBy[i], minimum, shift, mask)];
+            bufferGroupBy[position] = inputGroupBy[i];
+            ((std::get<I>(bufferAggregates)[position] =
+                    AggregateColumns::AggregatorType::init(std::get<I>(aggregateColumns).input[i])), ...);
+        }
+    }
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByAdaptiveMultiAggregateAuxSort(
+        int n, T1 *inputGroupBy, const std::tuple<AggregateColumns...> &aggregateColumns,
+        vectorOfPairs<int, int> &sectionsToBeSorted, groupByHashMap<T1, int> &map,
+        multiAggregateState<AggregateColumns...> &mapAggregates, T1 smallest, T1 largest) {
+    int i;
+    for (const auto &section: sectionsToBeSorted) {
+        keyRange(section.second - section.first, inputGroupBy + section.first, smallest, largest);
+    }
+    T1 minimum = smallest;
+    RadixPasses passes = radixPasses(smallest, largest,
+                                     (sizeof(typename AggregateColumns::StateType) + ... + sizeof(bool)));
+    int pass = passes.count - 1;
+    int shift = passes.shift[pass];
+    int numBuckets = passes.numBuckets(pass);
+    int mask = passes.mask(pass);
+    std::vector<int> buckets(passes.maxBuckets, 0);
+    multiAggregateState<AggregateColumns...> bucketAggregates{
+            std::vector<typename AggregateColumns::StateType>(passes.numBuckets(0))...};
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *inputBufferGroupBy = arena.allocate<T1>(n);
+    T1 *outputBufferGroupBy = arena.allocate<T1>(n);
+    multiAggregateStatePointers<AggregateColumns...> inputBufferAggregates;
+    multiAggregateStatePointers<AggregateColumns...> outputBufferAggregates;
+    allocateMultiAggregateBuffers(n, inputBufferAggregates, std::index_sequence_for<AggregateColumns...>{});
+    allocateMultiAggregateBuffers(n, outputBufferAggregates, std::index_sequence_for<AggregateColumns...>{});
+
+    // Every row is converted to a partial aggregate State as it is scattered, so that entries already aggregated in
+    // the hash table can be merged with the sorted sections
+    for (const auto &section: sectionsToBeSorted) {
+        for (i = section.first; i < section.second; i++) {
+            buckets[radixBucket(inputGroupBy[i], minimum, shift, mask)]++;
+        }
+    }
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        buckets[radixBucket(it->first, minimum, shift, mask)]++;
+    }
+
+    for (i = 1; i < numBuckets; i++) {
+        buckets[i] += buckets[i - 1];
+    }
+
+    int *partitions = arena.allocate<int>(numBuckets);
+    std::copy(buckets.begin(), buckets.begin() + numBuckets, partitions);
+
+    groupByAdaptiveMultiAggregateScatter<T1, AggregateColumns...>(sectionsToBeSorted, inputGroupBy,
+                                                                  aggregateColumns, map, mapAggregates,
+                                                                  inputBufferGroupBy, inputBufferAggregates,
+                                                                  minimum, shift, mask, buckets,
+                                                                  std::index_sequence_for<AggregateColumns...>{});
+
+    std::fill(buckets.begin(), buckets.begin() + numBuckets, 0);
+    --pass;
+
+    MultiAggregateResult<T1, typename AggregateColumns::ResultType...> result;
+    int partitionStart = 0;
+    for (i = 0; i < numBuckets; i++) {
+        if (partitions[i] > partitionStart) {
+            if (pass > 0) {
+                groupBySortMultiAggregateAux<true, T1, AggregateColumns...>(
+                        partitionStart, partitions[i], inputBufferGroupBy, inputBufferAggregates,
+                        outputBufferGroupBy, outputBufferAggregates, minimum, passes, buckets, pass,
+                        bucketAggregates, result);
+            } else {
+                groupBySortMultiAggregateAuxAgg<true, T1, AggregateColumns...>(
+                        partitionStart, partitions[i], inputBufferGroupBy, inputBufferAggregates, minimum, passes,
+                        bucketAggregates, result, std::index_sequence_for<AggregateColumns...>{});
+            }
+        }
+        partitionStart = partitions[i];
+    }
+
+    arena.rewind(arenaMark);
+
+    return result;
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByAdaptiveMultiAggregate(
+        int n, T1 *inputGroupBy, int cardinality, AggregateColumns... aggregateColumns) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert((std::is_arithmetic<typename AggregateColumns::ValueType>::value && ...),
+                  "Payload columns must be numeric types");
+
+    const GroupByAdaptiveParameters &parameters = getGroupByAdaptiveParameters();
+    int tuplesPerChunk = parameters.tuplesPerChunk;
+    int tuplesBetweenHashing = parameters.tuplesBetweenHashing;
+    int initialSize = std::max(static_cast<int>(2.5 * cardinality), 400000);
+
+    groupByHashMap<T1, int> map(initialSize);
+    multiAggregateState<AggregateColumns...> aggregates;
+    std::tuple<AggregateColumns...> columns = std::make_tuple(aggregateColumns...);
+
+    std::vector<std::string> counters = {"PERF_COUNT_HW_CACHE_MISSES"};
+    long_long *counterValues = Counters::getInstance().getEvents(counters);
+
+    int hashTableEntryBytes = sizeof(T1) + sizeof(int) + (sizeof(typename AggregateColumns::StateType) + ...);
+    float tuplesPerLastLevelCacheMissThreshold =
+            (parameters.machineConstant * bytesPerCacheLine()) / hashTableEntryBytes;
+
+    int index = 0;
+    int tuplesToProcess;
+
+    if (n > 0) {
+        T1 smallest = inputGroupBy[0];
+        T1 largest = inputGroupBy[0];
+        keyRange(std::min(tuplesPerChunk, n), inputGroupBy, smallest, largest);
+        if (denseKeyDomain(n, smallest, largest)) {
+            keyRange(n, inputGroupBy, smallest, largest);
+            if (denseKeyDomain(n, smallest, largest)) {
+                return groupByDenseMultiAggregateAux<T1, AggregateColumns...>(
+                        n, inputGroupBy, smallest, largest, columns, std::index_sequence_for<AggregateColumns...>{});
+            }
+        }
+    }
+
+    vectorOfPairs<int, int> sectionsToBeSorted;
+    int elements = 0;
+
+    // An empty section would leave nothing to read the initial key range from
+    if (n > 0 && groupBySortFromStart(cardinality, hashTableEntryBytes)) {
+        tuplesToProcess = std::min(tuplesBetweenHashing, n);
+        sectionsToBeSorted.emplace_back(0, tuplesToProcess);
+        index += tuplesToProcess;
+        elements += tuplesToProcess;
+    }
+
+    while (index < n) {
+
+        tuplesToProcess = std::min(tuplesPerChunk, n - index);
+
+        Counters::getInstance().readEventSet();
+
+        groupByHashMultiAggregateAux(tuplesToProcess, inputGroupBy, columns, map, aggregates, index);
+
+        Counters::getInstance().readEventSet();
+
+        if ((static_cast<float>(tuplesToProcess) / counterValues[0]) < tuplesPerLastLevelCacheMissThreshold) {
+            tuplesToProcess = std::min(tuplesBetweenHashing, n - index);
+
+            sectionsToBeSorted.emplace_back(index, index + tuplesToProcess);
+            index += tuplesToProcess;
+            elements += tuplesToProcess;
+        }
+    }
+
+    if (sectionsToBeSorted.empty()) {
+        return multiAggregateResultFromMap<T1, AggregateColumns...>(map, aggregates);
+    }
+
+    T1 mapSmallest = inputGroupBy[sectionsToBeSorted.front().first];
+    T1 mapLargest = inputGroupBy[sectionsToBeSorted.front().first];
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        mapSmallest = std::min(mapSmallest, it->first);
+        mapLargest = std::max(mapLargest, it->first);
+    }
+    elements += map.size();
+    return groupByAdaptiveMultiAggregateAuxSort<T1, AggregateColumns...>(elements, inputGroupBy, columns,
+                                                                         sectionsToBeSorted, map, aggregates,
+                                                                         mapSmallest, mapLargest);
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByHashMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns) {
+    return groupByHashMultiAggregate(n, inputGroupBy, estimateCardinality(n, inputGroupBy), aggregateColumns...);
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByAdaptiveMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns) {
+    return groupByAdaptiveMultiAggregate(n, inputGroupBy, estimateCardinality(n, inputGroupBy), aggregateColumns...);
+}
+
+template<typename T1, typename... AggregateColumns, size_t... I>
+inline void groupByHybridMultiAggregateAux(int n, const T1 *inputGroupBy,
+                                           const std::tuple<AggregateColumns...> &aggregateColumns,
+                                           groupByHashMap<T1, int> &map,
+                                           multiAggregateState<AggregateColumns...> &aggregates, int maxEntries,
+                                           T1 *&overflowGroupBy,
+                                           multiAggregateStatePointers<AggregateColumns...> &overflowAggregates,
+                                           int &overflow, int totalTuples, T1 &smallest, T1 &largest, int &index,
+                                           std::index_sequence<I...>) {
+    typename groupByHashMap<T1, int>::iterator it;
+    int startingIndex = index;
+    for (; index < startingIndex + n; ++index) {
+        it = map.find(inputGroupBy[index]);
+        if (it != map.end()) {
+            updateMultiAggregates(aggregates, it->second, aggregateColumns, index,
+                                  std::index_sequence_for<AggregateColumns...>{});
+        } else if (static_cast<int>(map.size()) < maxEntries) {
+            map.insert({inputGroupBy[index], static_cast<int>(map.size())});
+            appendMultiAggregates(aggregates, aggregateColumns, index, std::index_sequence_for<AggregateColumns...>{});
+        } else {
+            if (overflowGroupBy == nullptr) {
+                overflowGroupBy = MemoryArena::getInstance().allocate<T1>(totalTuples);
+                allocateMultiAggregateBuffers(totalTuples, overflowAggregates,
+                                              std::index_sequence_for<AggregateColumns...>{});
+            }
+            overflowGroupBy[overflow] = inputGroupBy[index];
+            ((std::get<I>(overflowAggregates)[overflow] =
+                    AggregateColumns::AggregatorType::init(std::get<I>(aggregateColumns).input[index])), ...);
+            overflow++;
+            smallest = std::min(smallest, inputGroupBy[index]);
+            largest = std::max(largest, inputGroupBy[index]);
+        }
+    }
+}
+
+template<typename T1, typename... AggregateColumns, size_t... I>
+inline void groupByHybridMultiAggregateFlush(groupByHashMap<T1, int> &map,
+                                             multiAggregateState<AggregateColumns...> &aggregates,
+                                             T1 *&overflowGroupBy,
+                                             multiAggregateStatePointers<AggregateColumns...> &overflowAggregates,
+                                             int &overflow, int totalTuples, T1 &smallest, T1 &largest,
+                                             std::index_sequence<I...>) {
+    if (overflowGroupBy == nullptr) {
+        overflowGroupBy = MemoryArena::getInstance().allocate<T1>(totalTuples);
+        allocateMultiAggregateBuffers(totalTuples, overflowAggregates, std::index_sequence_for<AggregateColumns...>{});
+    }
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        overflowGroupBy[overflow] = it->first;
+        ((std::get<I>(overflowAggregates)[overflow] = std::get<I>(aggregates)[it->second]), ...);
+        overflow++;
+        smallest = std::min(smallest, it->first);
+        largest = std::max(largest, it->first);
+    }
+    map.clear();
+    (std::get<I>(aggregates).clear(), ...);
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> groupByHybridMultiAggregate(
+        int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert((std::is_arithmetic<typename AggregateColumns::ValueType>::value && ...),
+                  "Payload columns must be numeric types");
+
+    int tuplesPerChunk = getGroupByAdaptiveParameters().tuplesPerChunk;
+    int maxEntries = groupByHybridTableEntries(
+            sizeof(T1) + sizeof(int) + (sizeof(typename AggregateColumns::StateType) + ...));
+
+    groupByHashMap<T1, int> map(2 * maxEntries);
+    multiAggregateState<AggregateColumns...> aggregates;
+    std::tuple<AggregateColumns...> columns = std::make_tuple(aggregateColumns...);
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+
+    T1 *overflowGroupBy = nullptr;
+    multiAggregateStatePointers<AggregateColumns...> overflowAggregates;
+    int overflow = 0;
+    T1 smallest = std::numeric_limits<T1>::max();
+    T1 largest = std::numeric_limits<T1>::lowest();
+
+    int index = 0;
+    int tuplesToProcess;
+    int overflowBeforeChunk;
+
+    while (index < n) {
+        tuplesToProcess = std::min(tuplesPerChunk, n - index);
+        overflowBeforeChunk = overflow;
+
+        groupByHybridMultiAggregateAux(tuplesToProcess, inputGroupBy, columns, map, aggregates, maxEntries,
+                                       overflowGroupBy, overflowAggregates, overflow, n, smallest, largest, index,
+                                       std::index_sequence_for<AggregateColumns...>{});
+
+        if (overflow - overflowBeforeChunk > tuplesToProcess / 2) {
+            groupByHybridMultiAggregateFlush<T1, AggregateColumns...>(map, aggregates, overflowGroupBy,
+                                                                      overflowAggregates, overflow, n, smallest,
+                                                                      largest,
+                                                                      std::index_sequence_for<AggregateColumns...>{});
+        }
+    }
+
+    if (overflow == 0) {
+        return multiAggregateResultFromMap<T1, AggregateColumns...>(map, aggregates);
+    }
+
+    groupByHybridMultiAggregateFlush<T1, AggregateColumns...>(map, aggregates, overflowGroupBy, overflowAggregates,
+                                                              overflow, n, smallest, largest,
+                                                              std::index_sequence_for<AggregateColumns...>{});
+
+    RadixPasses passes = radixPasses(smallest, largest,
+                                     (sizeof(typename AggregateColumns::StateType) + ... + sizeof(bool)));
+    std::vector<int> buckets(passes.maxBuckets, 0);
+    multiAggregateState<AggregateColumns...> bucketAggregates{
+            std::vector<typename AggregateColumns::StateType>(passes.numBuckets(0))...};
+
+    T1 *bufferGroupBy = arena.allocate<T1>(overflow);
+    multiAggregateStatePointers<AggregateColumns...> bufferAggregates;
+    allocateMultiAggregateBuffers(overflow, bufferAggregates, std::index_sequence_for<AggregateColumns...>{});
+
+    MultiAggregateResult<T1, typename AggregateColumns::ResultType...> result;
+    groupBySortMultiAggregateAux<true, T1, AggregateColumns...>(0, overflow, overflowGroupBy, overflowAggregates,
+                                                                bufferGroupBy, bufferAggregates, smallest, passes,
+                                                                buckets, passes.count - 1, bucketAggregates,
+                                                                result);
+
+    arena.rewind(arenaMark);
+
+    return result;
+}
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> runGroupByMultiAggregateFunction(
+        GroupBy groupByImplementation, int n, T1 *inputGroupBy, int cardinality, AggregateColumns... aggregateColumns) {
+    switch (groupByImplementation) {
+        case GroupBy::Hash:
+            return groupByHashMultiAggregate(n, inputGroupBy, cardinality, aggregateColumns...);
+        case GroupBy::Sort:
+            return groupBySortMultiAggregate(n, inputGroupBy, aggregateColumns...);
+        case GroupBy::Dense:
+            return groupByDenseMultiAggregate(n, inputGroupBy, aggregateColumns...);
+        case GroupBy::Hybrid:
+            return groupByHybridMultiAggregate(n, inputGroupBy, aggregateColumns...);
+        case GroupBy::Adaptive:
+            return groupByAdaptiveMultiAggregate(n, inputGroupBy, cardinality, aggregateColumns...);
+        default:
+            std::cout << "Invalid selection of 'GroupBy' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+
+template<typename T1, typename... AggregateColumns>
+MultiAggregateResult<T1, typename AggregateColumns::ResultType...> runGroupByMultiAggregateFunction(
+        GroupBy groupByImplementation, int n, T1 *inputGroupBy, AggregateColumns... aggregateColumns) {
+    int cardinality = 0;
+    if (groupByImplementation == GroupBy::Hash || groupByImplementation == GroupBy::Adaptive) {
+        cardinality = estimateCardinality(n, inputGroupBy);
     }
+    return runGroupByMultiAggregateFunction(groupByImplementation, n, inputGroupBy, cardinality, aggregateColumns...);
 }
 
 }
@@ -0,0 +1,52 @@
+#ifndef MABPL_GROUPBYOPERATOR_H
+#define MABPL_GROUPBYOPERATOR_H
+
+#include <vector>
+
+#include "groupBy.h"
+
+
+namespace MABPL {
+
+// Aggregates input that arrives in batches. The hash table, the rows deferred to the radix sort and the Adaptive
+// hash / sort decision are kept between calls to consume, so earlier batches are never revisited. Once the deferred
+// rows outnumber both tuplesBetweenHashing and the groups already compacted, they are radix aggregated together with
+// those groups into a single run of partial aggregates in key order, so that the memory held stays proportional to
+// the number of groups rather than of rows. finalize returns the groups seen since the last finalize and resets the
+// operator. Dense is not supported as it needs the key range of the whole input before the first row is aggregated.
+template<template<typename> class Aggregator, typename T1, typename T2>
+class GroupByOperator {
+public:
+    explicit GroupByOperator(GroupBy groupByImplementation, int cardinality = 0);
+    void consume(const T1 *inputGroupBy, const T2 *inputAggregate, int n);
+    vectorOfPairs<T1, T2> finalize();
+    int finalize(T1 *outputGroupBy, T2 *outputAggregate);
+
+private:
+    GroupBy groupByImplementation;
+    groupByHashMap<T1, T2> map;
+    int maxMapEntries;
+    std::vector<T1> deferredGroupBy;
+    std::vector<T2> deferredAggregate;
+    T1 deferredSmallest;
+    T1 deferredLargest;
+    vectorOfPairs<T1, T2> compactedRun;
+    int tuplesBetweenCompaction;
+    long tuplesDeferred;
+    int tuplesToDefer;
+    long_long *counterValues;
+    float tuplesPerLastLevelCacheMissThreshold;
+    void defer(T1 key, T2 state);
+    void hashChunk(const T1 *inputGroupBy, const T2 *inputAggregate, int n);
+    void deferMap();
+    void deferCompactedRun();
+    void compactDeferred();
+    template<typename Output>
+    void finalizeInto(Output &result);
+};
+
+}
+
+#include "groupByOperatorImplementation.h"
+
+#endif //MABPL_GROUPBYOPERATOR_H
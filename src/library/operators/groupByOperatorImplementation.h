@@ -0,0 +1,216 @@
+#ifndef MABPL_GROUPBYOPERATORIMPLEMENTATION_H
+#define MABPL_GROUPBYOPERATORIMPLEMENTATION_H
+
+#include <iostream>
+#include <limits>
+
+
+namespace MABPL {
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+GroupByOperator<Aggregator, T1, T2>::GroupByOperator(GroupBy groupByImplementation, int cardinality)
+        : groupByImplementation(groupByImplementation),
+          maxMapEntries(std::numeric_limits<int>::max()),
+          deferredSmallest(std::numeric_limits<T1>::max()),
+          deferredLargest(std::numeric_limits<T1>::lowest()),
+          tuplesBetweenCompaction(getGroupByAdaptiveParameters().tuplesBetweenHashing),
+          tuplesDeferred(0),
+          tuplesToDefer(0),
+          counterValues(nullptr),
+          tuplesPerLastLevelCacheMissThreshold(0) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
+
+    int hashTableEntryBytes = sizeof(T1) + sizeof(T2);
+    std::vector<std::string> counters = {"PERF_COUNT_HW_CACHE_MISSES"};
+
+    switch (groupByImplementation) {
+        case GroupBy::Sort:
+            break;
+        case GroupBy::Hybrid:
+            maxMapEntries = groupByHybridTableEntries(hashTableEntryBytes);
+            map.reserve(maxMapEntries);
+            break;
+        case GroupBy::Adaptive:
+            counterValues = Counters::getInstance().getEvents(counters);
+            tuplesPerLastLevelCacheMissThreshold =
+                    (getGroupByAdaptiveParameters().machineConstant * bytesPerCacheLine()) / hashTableEntryBytes;
+            map.reserve(std::max(static_cast<int>(2.5 * cardinality), 400000));
+            break;
+        case GroupBy::Hash:
+            map.reserve(std::max(static_cast<int>(2.5 * cardinality), 400000));
+            break;
+        default:
+            std::cout << "Invalid selection of 'GroupBy' implementation for a streaming group by!" << std::endl;
+            exit(1);
+    }
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+void GroupByOperator<Aggregator, T1, T2>::defer(T1 key, T2 state) {
+    deferredGroupBy.push_back(key);
+    deferredAggregate.push_back(state);
+    ++tuplesDeferred;
+    deferredSmallest = std::min(deferredSmallest, key);
+    deferredLargest = std::max(deferredLargest, key);
+    if (deferredGroupBy.size() >= std::max(static_cast<size_t>(tuplesBetweenCompaction), compactedRun.size())) {
+        compactDeferred();
+    }
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+void GroupByOperator<Aggregator, T1, T2>::hashChunk(const T1 *inputGroupBy, const T2 *inputAggregate, int n) {
+    typename groupByHashMap<T1, T2>::iterator it;
+    for (int i = 0; i < n; i++) {
+        it = map.find(inputGroupBy[i]);
+        if (it != map.end()) {
+            it.value() = Aggregator<T2>()(it->second, inputAggregate[i], false);
+        } else if (static_cast<int>(map.size()) < maxMapEntries) {
+            map.insert({inputGroupBy[i], Aggregator<T2>()(0, inputAggregate[i], true)});
+        } else {
+            defer(inputGroupBy[i], Aggregator<T2>::init(inputAggregate[i]));
+        }
+    }
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+void GroupByOperator<Aggregator, T1, T2>::deferMap() {
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        defer(it->first, it->second);
+    }
+    map.clear();
+}
+
+// The compacted run is appended without going through defer, as it must not trigger another compaction
+template<template<typename> class Aggregator, typename T1, typename T2>
+void GroupByOperator<Aggregator, T1, T2>::deferCompactedRun() {
+    for (const auto &entry : compactedRun) {
+        deferredGroupBy.push_back(entry.first);
+        deferredAggregate.push_back(entry.second);
+    }
+    compactedRun.clear();
+}
+
+// Deferred rows are already partial aggregates, so they merge with the compacted run in the leaves of the radix sort.
+// The key range of the deferred rows is kept, as it still covers the keys of the run.
+template<template<typename> class Aggregator, typename T1, typename T2>
+void GroupByOperator<Aggregator, T1, T2>::compactDeferred() {
+    deferCompactedRun();
+
+    int n = static_cast<int>(deferredGroupBy.size());
+    RadixPasses passes = radixPasses(deferredSmallest, deferredLargest, sizeof(T2) + sizeof(bool));
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *bufferGroupBy = arena.allocate<T1>(n);
+    T2 *bufferAggregate = arena.allocate<T2>(n);
+
+    groupBySortAux<Aggregator, true>(0, n, deferredGroupBy.data(), deferredAggregate.data(), bufferGroupBy,
+                                     bufferAggregate, deferredSmallest, passes, passes.count - 1, compactedRun);
+
+    arena.rewind(arenaMark);
+
+    deferredGroupBy.clear();
+    deferredAggregate.clear();
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+void GroupByOperator<Aggregator, T1, T2>::consume(const T1 *inputGroupBy, const T2 *inputAggregate, int n) {
+    int tuplesPerChunk = getGroupByAdaptiveParameters().tuplesPerChunk;
+    int tuplesBetweenHashing = getGroupByAdaptiveParameters().tuplesBetweenHashing;
+
+    int index = 0;
+    int tuplesToProcess;
+    long deferredBeforeChunk;
+
+    if (groupByImplementation == GroupBy::Sort) {
+        for (; index < n; index++) {
+            defer(inputGroupBy[index], Aggregator<T2>::init(inputAggregate[index]));
+        }
+        return;
+    }
+
+    while (index < n) {
+        // A decision to sort made near the end of one batch carries over into the next
+        if (tuplesToDefer > 0) {
+            tuplesToProcess = std::min(tuplesToDefer, n - index);
+            for (int i = index; i < index + tuplesToProcess; i++) {
+                defer(inputGroupBy[i], Aggregator<T2>::init(inputAggregate[i]));
+            }
+            tuplesToDefer -= tuplesToProcess;
+            index += tuplesToProcess;
+            continue;
+        }
+
+        tuplesToProcess = std::min(tuplesPerChunk, n - index);
+        deferredBeforeChunk = tuplesDeferred;
+
+        if (groupByImplementation == GroupBy::Adaptive) {
+            Counters::getInstance().readEventSet();
+            hashChunk(inputGroupBy + index, inputAggregate + index, tuplesToProcess);
+            Counters::getInstance().readEventSet();
+
+            if ((static_cast<float>(tuplesToProcess) / counterValues[0]) < tuplesPerLastLevelCacheMissThreshold) {
+                tuplesToDefer = tuplesBetweenHashing;
+            }
+        } else {
+            hashChunk(inputGroupBy + index, inputAggregate + index, tuplesToProcess);
+        }
+
+        if (groupByImplementation == GroupBy::Hybrid &&
+            tuplesDeferred - deferredBeforeChunk > tuplesToProcess / 2) {
+            deferMap();
+        }
+        index += tuplesToProcess;
+    }
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+template<typename Output>
+void GroupByOperator<Aggregator, T1, T2>::finalizeInto(Output &result) {
+    if (deferredGroupBy.empty() && compactedRun.empty()) {
+        writeGroupByMap(map, result);
+        map.clear();
+    } else {
+        deferMap();
+        deferCompactedRun();
+
+        int n = static_cast<int>(deferredGroupBy.size());
+        RadixPasses passes = radixPasses(deferredSmallest, deferredLargest, sizeof(T2) + sizeof(bool));
+        MemoryArena &arena = MemoryArena::getInstance();
+        ArenaMark arenaMark = arena.mark();
+        T1 *bufferGroupBy = arena.allocate<T1>(n);
+        T2 *bufferAggregate = arena.allocate<T2>(n);
+
+        groupBySortAux<Aggregator, true>(0, n, deferredGroupBy.data(), deferredAggregate.data(), bufferGroupBy,
+                                         bufferAggregate, deferredSmallest, passes, passes.count - 1, result);
+
+        arena.rewind(arenaMark);
+
+        std::vector<T1>().swap(deferredGroupBy);
+        std::vector<T2>().swap(deferredAggregate);
+        vectorOfPairs<T1, T2>().swap(compactedRun);
+    }
+
+    // A sort decision or key range left by the last batch must not carry over into the next stream
+    deferredSmallest = std::numeric_limits<T1>::max();
+    deferredLargest = std::numeric_limits<T1>::lowest();
+    tuplesToDefer = 0;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+vectorOfPairs<T1, T2> GroupByOperator<Aggregator, T1, T2>::finalize() {
+    vectorOfPairs<T1, T2> result;
+    finalizeInto(result);
+    return result;
+}
+
+template<template<typename> class Aggregator, typename T1, typename T2>
+int GroupByOperator<Aggregator, T1, T2>::finalize(T1 *outputGroupBy, T2 *outputAggregate) {
+    ColumnarGroupByOutput<T1, T2> result{outputGroupBy, outputAggregate, 0};
+    finalizeInto(result);
+    return static_cast<int>(result.size());
+}
+
+}
+
+#endif //MABPL_GROUPBYOPERATORIMPLEMENTATION_H
@@ -0,0 +1,42 @@
+#include <iostream>
+
+#include "join.h"
+
+
+namespace MABPL {
+
+std::string getJoinName(Join joinImplementation) {
+    switch (joinImplementation) {
+        case Join::JoinHash:
+            return "Join_Hash";
+        case Join::JoinRadix:
+            return "Join_Radix";
+        case Join::JoinAdaptive:
+            return "Join_Adaptive";
+        default:
+            std::cout << "Invalid selection of 'Join' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+std::string getSemiJoinName(SemiJoin semiJoinImplementation) {
+    switch (semiJoinImplementation) {
+        case SemiJoin::ImplementationSemiJoinHash:
+            return "SemiJoin_Hash";
+        case SemiJoin::ImplementationSemiJoinBloom:
+            return "SemiJoin_Bloom";
+        case SemiJoin::ImplementationSemiJoinAdaptive:
+            return "SemiJoin_Adaptive";
+        case SemiJoin::ImplementationAntiJoinHash:
+            return "AntiJoin_Hash";
+        case SemiJoin::ImplementationAntiJoinBloom:
+            return "AntiJoin_Bloom";
+        case SemiJoin::ImplementationAntiJoinAdaptive:
+            return "AntiJoin_Adaptive";
+        default:
+            std::cout << "Invalid selection of 'SemiJoin' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
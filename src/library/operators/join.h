@@ -0,0 +1,128 @@
+#ifndef MABPL_JOIN_H
+#define MABPL_JOIN_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace MABPL {
+
+enum Join {
+    JoinHash,
+    JoinRadix,
+    JoinAdaptive
+};
+
+enum SemiJoin {
+    ImplementationSemiJoinHash,
+    ImplementationSemiJoinBloom,
+    ImplementationSemiJoinAdaptive,
+    ImplementationAntiJoinHash,
+    ImplementationAntiJoinBloom,
+    ImplementationAntiJoinAdaptive
+};
+
+std::string getJoinName(Join joinImplementation);
+std::string getSemiJoinName(SemiJoin semiJoinImplementation);
+
+// Rows of the build and probe inputs with equal keys, one entry per matching pair
+struct JoinIndexes {
+    std::vector<int> build;
+    std::vector<int> probe;
+    [[nodiscard]] size_t size() const { return build.size(); }
+};
+
+template<typename T, typename T1, typename T2>
+struct JoinResult {
+    std::vector<T> key;
+    std::vector<T1> buildPayload;
+    std::vector<T2> probePayload;
+    [[nodiscard]] size_t size() const { return key.size(); }
+};
+
+// Equi-joins on integer keys, emitting every pair of matching rows in no particular order. joinHash builds one bucket
+// chained table over the whole build input. joinRadix first partitions both inputs on the key hash so that the table
+// of each build partition stays cache resident. joinAdaptive starts with joinHash and switches to joinRadix for the
+// rest of the input once last level cache misses per tuple show that the table has outgrown the cache.
+template<typename T>
+JoinIndexes joinHash(int buildN, const T *buildKeys, int probeN, const T *probeKeys);
+
+template<typename T>
+JoinIndexes joinRadix(int buildN, const T *buildKeys, int probeN, const T *probeKeys);
+
+template<typename T>
+JoinIndexes joinAdaptive(int buildN, const T *buildKeys, int probeN, const T *probeKeys);
+
+template<typename T>
+JoinIndexes runJoinFunction(Join joinImplementation, int buildN, const T *buildKeys, int probeN, const T *probeKeys);
+
+// Materialising forms copy the key and the payload of both matching rows into the result
+template<typename T, typename T1, typename T2>
+JoinResult<T, T1, T2> joinHash(int buildN, const T *buildKeys, const T1 *buildPayload, int probeN,
+                               const T *probeKeys, const T2 *probePayload);
+
+template<typename T, typename T1, typename T2>
+JoinResult<T, T1, T2> joinRadix(int buildN, const T *buildKeys, const T1 *buildPayload, int probeN,
+                                const T *probeKeys, const T2 *probePayload);
+
+template<typename T, typename T1, typename T2>
+JoinResult<T, T1, T2> joinAdaptive(int buildN, const T *buildKeys, const T1 *buildPayload, int probeN,
+                                   const T *probeKeys, const T2 *probePayload);
+
+template<typename T, typename T1, typename T2>
+JoinResult<T, T1, T2> runJoinFunction(Join joinImplementation, int buildN, const T *buildKeys, const T1 *buildPayload,
+                                      int probeN, const T *probeKeys, const T2 *probePayload);
+
+
+// Key set of a semi or anti join, built once and probed by any number of inputs. Keys are held in a bucket chained
+// table behind a register blocked Bloom filter, where each key sets four bits of a single 64-bit word.
+template<typename T>
+class JoinKeySet {
+public:
+    JoinKeySet(int n, const T *keys);
+    [[nodiscard]] bool contains(T key) const;
+    [[nodiscard]] bool mayContain(T key) const;
+    [[nodiscard]] long tableBytes() const;
+
+private:
+    std::vector<T> keys;
+    std::vector<int> heads;
+    std::vector<int> next;
+    int shift;
+    int mask;
+    std::vector<uint64_t> bloomWords;
+    int bloomShift;
+};
+
+// Semi joins select the indexes of the input rows whose key is in the key set and anti joins those whose key is not,
+// with the output conventions of selectIndexes*. The Bloom variants test the filter before the table. The adaptive
+// variants turn the filter on or off every chunk from the fraction of rows passing it and the cache misses per
+// table probe.
+template<typename T>
+int semiJoinIndexesHash(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet);
+
+template<typename T>
+int semiJoinIndexesBloom(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet);
+
+template<typename T>
+int semiJoinIndexesAdaptive(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet);
+
+template<typename T>
+int antiJoinIndexesHash(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet);
+
+template<typename T>
+int antiJoinIndexesBloom(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet);
+
+template<typename T>
+int antiJoinIndexesAdaptive(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet);
+
+template<typename T>
+int runSemiJoinFunction(SemiJoin semiJoinImplementation, int n, const T *inputFilter, int *selection,
+                        const JoinKeySet<T> &keySet);
+
+}
+
+#include "joinImplementation.h"
+
+#endif //MABPL_JOIN_H
@@ -0,0 +1,594 @@
+#ifndef MABPL_JOINIMPLEMENTATION_H
+#define MABPL_JOINIMPLEMENTATION_H
+
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#include "groupBy.h"
+#include "../utilities/systemInformation.h"
+#include "../utilities/papi.h"
+#include "../utilities/memoryArena.h"
+
+
+namespace MABPL {
+
+constexpr float JOIN_MACHINE_CONSTANT = 0.5;
+constexpr int JOIN_TUPLES_PER_CHUNK = 75 * 1000;
+constexpr int JOIN_PARTITION_FROM_START_LLC_MULTIPLE = 4;
+constexpr float JOIN_PARTITION_L2_FRACTION = 0.5;
+constexpr uint64_t JOIN_HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+constexpr int JOIN_BLOOM_BITS_PER_KEY = 16;
+constexpr int SEMIJOIN_TUPLES_PER_ADAPTION = 50000;
+constexpr float SEMIJOIN_BLOOM_MAX_PASS_RATE = 0.25;
+constexpr float SEMIJOIN_BLOOM_MIN_MISSES_PER_PROBE = 0.2;
+
+// Fibonacci hashing, whose high bits are well mixed. Partitions are taken from the top bits of the hash and the buckets
+// of a partition's table from the bits below them.
+template<typename T>
+inline uint64_t joinKeyHash(T key) {
+    return static_cast<uint64_t>(key) * JOIN_HASH_MULTIPLIER;
+}
+
+template<typename T>
+inline int joinBucket(T key, int shift, int mask) {
+    return static_cast<int>((joinKeyHash(key) >> shift) & mask);
+}
+
+// Bloom filter words are selected by the top bits of the hash and the four bits set within a word by bits below them
+inline uint64_t joinBloomBits(uint64_t hash) {
+    return (1ULL << ((hash >> 14) & 63)) | (1ULL << ((hash >> 20) & 63)) | (1ULL << ((hash >> 26) & 63)) |
+           (1ULL << ((hash >> 32) & 63));
+}
+
+// A build row costs its key, its chain link and about one bucket head
+template<typename T>
+constexpr int joinTableEntryBytes() {
+    return sizeof(T) + 2 * sizeof(int);
+}
+
+inline int joinTableBits(int buildN) {
+    int bits = 1;
+    while ((1L << bits) < buildN) {
+        bits++;
+    }
+    return bits;
+}
+
+inline bool joinPartitionFromStart(int buildN, int tableEntryBytes) {
+    return static_cast<long>(buildN) * tableEntryBytes > JOIN_PARTITION_FROM_START_LLC_MULTIPLE * l3cacheSize();
+}
+
+// Enough partitions for the table of each build partition to fit a fraction of L2, made in at most two passes
+inline int joinPartitionBits(int buildN, int tableEntryBytes) {
+    static const long partitionBytes =
+            static_cast<long>(JOIN_PARTITION_L2_FRACTION * (l2cacheSize() > 0 ? l2cacheSize() : 256 * 1024));
+    long partitions = (static_cast<long>(buildN) * tableEntryBytes + partitionBytes - 1) / partitionBytes;
+    int bits = 0;
+    while ((1L << bits) < partitions) {
+        bits++;
+    }
+    return std::min(bits, 2 * radixPartitionBits());
+}
+
+// Matches are written through emplace_back(buildRow, probeRow), so the same code collects row indexes or payloads
+struct JoinIndexesOutput {
+    JoinIndexes &result;
+    void emplace_back(int buildRow, int probeRow) {
+        result.build.push_back(buildRow);
+        result.probe.push_back(probeRow);
+    }
+};
+
+template<typename T, typename T1, typename T2>
+struct JoinPayloadOutput {
+    const T *buildKeys;
+    const T1 *buildPayload;
+    const T2 *probePayload;
+    JoinResult<T, T1, T2> &result;
+    void emplace_back(int buildRow, int probeRow) {
+        result.key.push_back(buildKeys[buildRow]);
+        result.buildPayload.push_back(buildPayload[buildRow]);
+        result.probePayload.push_back(probePayload[probeRow]);
+    }
+};
+
+// Maps the positions of a partition back to the rows of the inputs
+template<typename Output>
+struct JoinPartitionOutput {
+    const int *buildRows;
+    const int *probeRows;
+    Output &result;
+    void emplace_back(int buildRow, int probeRow) {
+        result.emplace_back(buildRows[buildRow], probeRows[probeRow]);
+    }
+};
+
+template<typename Output>
+struct JoinProbeOffsetOutput {
+    int probeOffset;
+    Output &result;
+    void emplace_back(int buildRow, int probeRow) {
+        result.emplace_back(buildRow, probeRow + probeOffset);
+    }
+};
+
+// Bucket chained table: heads holds the last build row inserted into each bucket and next the row inserted before it
+// into the same bucket, both ending in -1
+template<typename T>
+inline void joinBuildAux(int start, int end, const T *buildKeys, int *heads, int *next, int shift, int mask) {
+    for (int i = start; i < end; i++) {
+        int bucket = joinBucket(buildKeys[i], shift, mask);
+        next[i] = heads[bucket];
+        heads[bucket] = i;
+    }
+}
+
+template<typename T, typename Output>
+inline void joinProbeAux(int start, int end, const T *probeKeys, const T *buildKeys, const int *heads,
+                         const int *next, int shift, int mask, Output &result) {
+    for (int i = start; i < end; i++) {
+        T key = probeKeys[i];
+        for (int row = heads[joinBucket(key, shift, mask)]; row != -1; row = next[row]) {
+            if (buildKeys[row] == key) {
+                result.emplace_back(row, i);
+            }
+        }
+    }
+}
+
+// Joins one partition, whose keys share their top partitionBits hash bits, with a table indexed by the bits below them
+template<typename T, typename Output>
+void joinPartitionAux(int buildN, const T *buildKeys, int probeN, const T *probeKeys, int partitionBits,
+                      Output &result) {
+    if (buildN == 0 || probeN == 0) {
+        return;
+    }
+
+    int tableBits = joinTableBits(buildN);
+    int shift = 64 - partitionBits - tableBits;
+    int mask = (1 << tableBits) - 1;
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    int *heads = arena.allocate<int>(1 << tableBits);
+    int *next = arena.allocate<int>(buildN);
+    std::fill(heads, heads + (1 << tableBits), -1);
+
+    joinBuildAux(0, buildN, buildKeys, heads, next, shift, mask);
+    joinProbeAux(0, probeN, probeKeys, buildKeys, heads, next, shift, mask, result);
+
+    arena.rewind(arenaMark);
+}
+
+// Scatters rows [start, end) on the hash bits selected by shift and mask. Rows of a first pass are the input positions,
+// passed as nullptr. partitions receives mask + 2 offsets, the start of each partition followed by end.
+template<typename T>
+inline void joinScatter(int start, int end, const T *keys, const int *rows, T *outputKeys, int *outputRows, int shift,
+                        int mask, int *partitions) {
+    int i;
+    std::fill(partitions, partitions + mask + 2, 0);
+    for (i = start; i < end; i++) {
+        partitions[joinBucket(keys[i], shift, mask) + 1]++;
+    }
+    partitions[0] = start;
+    for (i = 1; i < mask + 2; i++) {
+        partitions[i] += partitions[i - 1];
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    int *positions = arena.allocate<int>(mask + 1);
+    std::copy(partitions, partitions + mask + 1, positions);
+    for (i = start; i < end; i++) {
+        int position = positions[joinBucket(keys[i], shift, mask)]++;
+        outputKeys[position] = keys[i];
+        outputRows[position] = rows != nullptr ? rows[i] : i;
+    }
+    arena.rewind(arenaMark);
+}
+
+template<typename T, typename Output>
+void joinRadixInto(int buildN, const T *buildKeys, int probeN, const T *probeKeys, Output &result) {
+    static_assert(std::is_integral<T>::value, "Join keys must be an integer type");
+
+    int partitionBits = joinPartitionBits(buildN, joinTableEntryBytes<T>());
+    if (partitionBits == 0 || probeN == 0) {
+        joinPartitionAux(buildN, buildKeys, probeN, probeKeys, 0, result);
+        return;
+    }
+
+    int firstBits = partitionBits > radixPartitionBits() ? (partitionBits + 1) / 2 : partitionBits;
+    int secondBits = partitionBits - firstBits;
+    int firstMask = (1 << firstBits) - 1;
+    int secondMask = (1 << secondBits) - 1;
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T *buildPartitionKeys = arena.allocate<T>(buildN);
+    int *buildPartitionRows = arena.allocate<int>(buildN);
+    T *probePartitionKeys = arena.allocate<T>(probeN);
+    int *probePartitionRows = arena.allocate<int>(probeN);
+    int *buildPartitions = arena.allocate<int>(firstMask + 2);
+    int *probePartitions = arena.allocate<int>(firstMask + 2);
+
+    joinScatter(0, buildN, buildKeys, nullptr, buildPartitionKeys, buildPartitionRows, 64 - firstBits, firstMask,
+                buildPartitions);
+    joinScatter(0, probeN, probeKeys, nullptr, probePartitionKeys, probePartitionRows, 64 - firstBits, firstMask,
+                probePartitions);
+
+    T *buildSubPartitionKeys = nullptr;
+    int *buildSubPartitionRows = nullptr;
+    T *probeSubPartitionKeys = nullptr;
+    int *probeSubPartitionRows = nullptr;
+    int *buildSubPartitions = nullptr;
+    int *probeSubPartitions = nullptr;
+    if (secondBits > 0) {
+        buildSubPartitionKeys = arena.allocate<T>(buildN);
+        buildSubPartitionRows = arena.allocate<int>(buildN);
+        probeSubPartitionKeys = arena.allocate<T>(probeN);
+        probeSubPartitionRows = arena.allocate<int>(probeN);
+        buildSubPartitions = arena.allocate<int>(secondMask + 2);
+        probeSubPartitions = arena.allocate<int>(secondMask + 2);
+    }
+
+    for (int i = 0; i <= firstMask; i++) {
+        int buildStart = buildPartitions[i];
+        int probeStart = probePartitions[i];
+        int buildEnd = buildPartitions[i + 1];
+        int probeEnd = probePartitions[i + 1];
+        if (buildEnd == buildStart || probeEnd == probeStart) {
+            continue;
+        }
+
+        if (secondBits == 0) {
+            JoinPartitionOutput<Output> partitionResult{buildPartitionRows + buildStart,
+                                                        probePartitionRows + probeStart, result};
+            joinPartitionAux(buildEnd - buildStart, buildPartitionKeys + buildStart, probeEnd - probeStart,
+                             probePartitionKeys + probeStart, partitionBits, partitionResult);
+            continue;
+        }
+
+        joinScatter(buildStart, buildEnd, buildPartitionKeys, buildPartitionRows, buildSubPartitionKeys,
+                    buildSubPartitionRows, 64 - partitionBits, secondMask, buildSubPartitions);
+        joinScatter(probeStart, probeEnd, probePartitionKeys, probePartitionRows, probeSubPartitionKeys,
+                    probeSubPartitionRows, 64 - partitionBits, secondMask, probeSubPartitions);
+        for (int j = 0; j <= secondMask; j++) {
+            int subBuildStart = buildSubPartitions[j];
+            int subProbeStart = probeSubPartitions[j];
+            JoinPartitionOutput<Output> partitionResult{buildSubPartitionRows + subBuildStart,
+                                                        probeSubPartitionRows + subProbeStart, result};
+            joinPartitionAux(buildSubPartitions[j + 1] - subBuildStart, buildSubPartitionKeys + subBuildStart,
+                             probeSubPartitions[j + 1] - subProbeStart, probeSubPartitionKeys + subProbeStart,
+                             partitionBits, partitionResult);
+        }
+    }
+
+    arena.rewind(arenaMark);
+}
+
+template<typename T, typename Output>
+void joinHashInto(int buildN, const T *buildKeys, int probeN, const T *probeKeys, Output &result) {
+    static_assert(std::is_integral<T>::value, "Join keys must be an integer type");
+    joinPartitionAux(buildN, buildKeys, probeN, probeKeys, 0, result);
+}
+
+// The table is built and probed chunk by chunk, reading the last level cache misses of each chunk as the adaptive
+// group by does. Too many misses per tuple mean the table has outgrown the cache, and the remaining probe input is
+// joined with radix partitioning instead. Partitioning rereads the whole build input, so it is only chosen while at
+// least as many probe tuples remain.
+template<typename T, typename Output>
+void joinAdaptiveInto(int buildN, const T *buildKeys, int probeN, const T *probeKeys, Output &result) {
+    static_assert(std::is_integral<T>::value, "Join keys must be an integer type");
+
+    int tableEntryBytes = joinTableEntryBytes<T>();
+    if (buildN == 0 || probeN == 0) {
+        return;
+    }
+    if (probeN >= buildN && joinPartitionFromStart(buildN, tableEntryBytes)) {
+        joinRadixInto(buildN, buildKeys, probeN, probeKeys, result);
+        return;
+    }
+
+    std::vector<std::string> counters = {"PERF_COUNT_HW_CACHE_MISSES"};
+    long_long *counterValues = Counters::getInstance().getEvents(counters);
+    float tuplesPerLastLevelCacheMissThreshold = (JOIN_MACHINE_CONSTANT * bytesPerCacheLine()) / tableEntryBytes;
+
+    int tableBits = joinTableBits(buildN);
+    int shift = 64 - tableBits;
+    int mask = (1 << tableBits) - 1;
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    int *heads = arena.allocate<int>(1 << tableBits);
+    int *next = arena.allocate<int>(buildN);
+    std::fill(heads, heads + (1 << tableBits), -1);
+
+    int index = 0;
+    int tuplesToProcess;
+
+    while (index < buildN) {
+        tuplesToProcess = std::min(JOIN_TUPLES_PER_CHUNK, buildN - index);
+
+        Counters::getInstance().readEventSet();
+        joinBuildAux(index, index + tuplesToProcess, buildKeys, heads, next, shift, mask);
+        Counters::getInstance().readEventSet();
+        index += tuplesToProcess;
+
+        if (index < buildN && probeN >= buildN &&
+            (static_cast<float>(tuplesToProcess) / counterValues[0]) < tuplesPerLastLevelCacheMissThreshold) {
+            arena.rewind(arenaMark);
+            joinRadixInto(buildN, buildKeys, probeN, probeKeys, result);
+            return;
+        }
+    }
+
+    index = 0;
+    while (index < probeN) {
+        tuplesToProcess = std::min(JOIN_TUPLES_PER_CHUNK, probeN - index);
+
+        Counters::getInstance().readEventSet();
+        joinProbeAux(index, index + tuplesToProcess, probeKeys, buildKeys, heads, next, shift, mask, result);
+        Counters::getInstance().readEventSet();
+        index += tuplesToProcess;
+
+        if (probeN - index >= buildN &&
+            (static_cast<float>(tuplesToProcess) / counterValues[0]) < tuplesPerLastLevelCacheMissThreshold) {
+            JoinProbeOffsetOutput<Output> remainingResult{index, result};
+            joinRadixInto(buildN, buildKeys, probeN - index, probeKeys + index, remainingResult);
+            break;
+        }
+    }
+
+    arena.rewind(arenaMark);
+}
+
+template<typename T, typename Output>
+void runJoinFunctionInto(Join joinImplementation, int buildN, const T *buildKeys, int probeN, const T *probeKeys,
+                         Output &result) {
+    switch (joinImplementation) {
+        case Join::JoinHash:
+            joinHashInto(buildN, buildKeys, probeN, probeKeys, result);
+            break;
+        case Join::JoinRadix:
+            joinRadixInto(buildN, buildKeys, probeN, probeKeys, result);
+            break;
+        case Join::JoinAdaptive:
+            joinAdaptiveInto(buildN, buildKeys, probeN, probeKeys, result);
+            break;
+        default:
+            std::cout << "Invalid selection of 'Join' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+template<typename T>
+JoinIndexes joinHash(int buildN, const T *buildKeys, int probeN, const T *probeKeys) {
+    return runJoinFunction(Join::JoinHash, buildN, buildKeys, probeN, probeKeys);
+}
+
+template<typename T>
+JoinIndexes joinRadix(int buildN, const T *buildKeys, int probeN, const T *probeKeys) {
+    return runJoinFunction(Join::JoinRadix, buildN, buildKeys, probeN, probeKeys);
+}
+
+template<typename T>
+JoinIndexes joinAdaptive(int buildN, const T *buildKeys, int probeN, const T *probeKeys) {
+    return runJoinFunction(Join::JoinAdaptive, buildN, buildKeys, probeN, probeKeys);
+}
+
+template<typename T>
+JoinIndexes runJoinFunction(Join joinImplementation, int buildN, const T *buildKeys, int probeN, const T *probeKeys) {
+    JoinIndexes result;
+    JoinIndexesOutput output{result};
+    runJoinFunctionInto(joinImplementation, buildN, buildKeys, probeN, probeKeys, output);
+    return result;
+}
+
+template<typename T, typename T1, typename T2>
+JoinResult<T, T1, T2> joinHash(int buildN, const T *buildKeys, const T1 *buildPayload, int probeN,
+                               const T *probeKeys, const T2 *probePayload) {
+    return runJoinFunction(Join::JoinHash, buildN, buildKeys, buildPayload, probeN, probeKeys, probePayload);
+}
+
+template<typename T, typename T1, typename T2>
+JoinResult<T, T1, T2> joinRadix(int buildN, const T *buildKeys, const T1 *buildPayload, int probeN,
+                                const T *probeKeys, const T2 *probePayload) {
+    return runJoinFunction(Join::JoinRadix, buildN, buildKeys, buildPayload, probeN, probeKeys, probePayload);
+}
+
+template<typename T, typename T1, typename T2>
+JoinResult<T, T1, T2> joinAdaptive(int buildN, const T *buildKeys, const T1 *buildPayload, int probeN,
+                                   const T *probeKeys, const T2 *probePayload) {
+    return runJoinFunction(Join::JoinAdaptive, buildN, buildKeys, buildPayload, probeN, probeKeys, probePayload);
+}
+
+template<typename T, typename T1, typename T2>
+JoinResult<T, T1, T2> runJoinFunction(Join joinImplementation, int buildN, const T *buildKeys, const T1 *buildPayload,
+                                      int probeN, const T *probeKeys, const T2 *probePayload) {
+    JoinResult<T, T1, T2> result;
+    JoinPayloadOutput<T, T1, T2> output{buildKeys, buildPayload, probePayload, result};
+    runJoinFunctionInto(joinImplementation, buildN, buildKeys, probeN, probeKeys, output);
+    return result;
+}
+
+
+template<typename T>
+JoinKeySet<T>::JoinKeySet(int n, const T *keys) : keys(keys, keys + n), next(n) {
+    static_assert(std::is_integral<T>::value, "Join keys must be an integer type");
+
+    int tableBits = joinTableBits(n);
+    shift = 64 - tableBits;
+    mask = (1 << tableBits) - 1;
+    heads.assign(1 << tableBits, -1);
+    joinBuildAux(0, n, keys, heads.data(), next.data(), shift, mask);
+
+    int bloomWordBits = joinTableBits(static_cast<int>(std::max(1L, static_cast<long>(n) *
+                                                                    JOIN_BLOOM_BITS_PER_KEY / 64)));
+    bloomShift = 64 - bloomWordBits;
+    bloomWords.assign(1 << bloomWordBits, 0);
+    for (int i = 0; i < n; i++) {
+        uint64_t hash = joinKeyHash(keys[i]);
+        bloomWords[hash >> bloomShift] |= joinBloomBits(hash);
+    }
+}
+
+template<typename T>
+bool JoinKeySet<T>::contains(T key) const {
+    for (int row = heads[joinBucket(key, shift, mask)]; row != -1; row = next[row]) {
+        if (keys[row] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T>
+bool JoinKeySet<T>::mayContain(T key) const {
+    uint64_t hash = joinKeyHash(key);
+    uint64_t bits = joinBloomBits(hash);
+    return (bloomWords[hash >> bloomShift] & bits) == bits;
+}
+
+template<typename T>
+long JoinKeySet<T>::tableBytes() const {
+    return static_cast<long>(keys.size()) * (sizeof(T) + sizeof(int)) + static_cast<long>(heads.size()) * sizeof(int);
+}
+
+template<bool anti, typename T>
+inline int semiJoinIndexesHashAux(int start, int end, const T *inputFilter, int *selection,
+                                  const JoinKeySet<T> &keySet) {
+    int k = 0;
+    for (int i = start; i < end; ++i) {
+        if (keySet.contains(inputFilter[i]) != anti) {
+            selection[k++] = i;
+        }
+    }
+    return k;
+}
+
+template<bool anti, typename T>
+inline int semiJoinIndexesBloomAux(int start, int end, const T *inputFilter, int *selection,
+                                   const JoinKeySet<T> &keySet, int &bloomPassed) {
+    int k = 0;
+    for (int i = start; i < end; ++i) {
+        if (keySet.mayContain(inputFilter[i])) {
+            bloomPassed++;
+            if (keySet.contains(inputFilter[i]) != anti) {
+                selection[k++] = i;
+            }
+        } else if (anti) {
+            selection[k++] = i;
+        }
+    }
+    return k;
+}
+
+// A filter only pays off while it rejects most rows and the table probes it saves miss the cache. The counter only sees
+// last level cache misses, so a table larger than L2 is taken to miss as well. With the filter off, the rows with a key
+// in the set stand in for the rows that would pass it.
+inline void performSemiJoinAdaption(bool &useBloomFilter, float passRate, float missesPerProbe, bool tableOutgrowsL2) {
+    useBloomFilter = passRate < SEMIJOIN_BLOOM_MAX_PASS_RATE &&
+                     (missesPerProbe > SEMIJOIN_BLOOM_MIN_MISSES_PER_PROBE || tableOutgrowsL2);
+}
+
+template<bool anti, typename T>
+int semiJoinIndexesAdaptiveAux(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet) {
+    bool tableOutgrowsL2 = keySet.tableBytes() > l2cacheSize();
+    bool useBloomFilter = tableOutgrowsL2;
+
+    std::vector<std::string> counters = {"PERF_COUNT_HW_CACHE_MISSES"};
+    long_long *counterValues = Counters::getInstance().getEvents(counters);
+
+    int k = 0;
+    int index = 0;
+    while (index < n) {
+        int tuplesToProcess = std::min(SEMIJOIN_TUPLES_PER_ADAPTION, n - index);
+        int selected;
+        float passRate;
+        float tableProbes;
+
+        Counters::getInstance().readEventSet();
+        if (useBloomFilter) {
+            int bloomPassed = 0;
+            selected = semiJoinIndexesBloomAux<anti>(index, index + tuplesToProcess, inputFilter, selection + k,
+                                                     keySet, bloomPassed);
+            passRate = static_cast<float>(bloomPassed) / static_cast<float>(tuplesToProcess);
+            tableProbes = static_cast<float>(std::max(bloomPassed, 1));
+        } else {
+            selected = semiJoinIndexesHashAux<anti>(index, index + tuplesToProcess, inputFilter, selection + k,
+                                                    keySet);
+            int matched = anti ? tuplesToProcess - selected : selected;
+            passRate = static_cast<float>(matched) / static_cast<float>(tuplesToProcess);
+            tableProbes = static_cast<float>(tuplesToProcess);
+        }
+        Counters::getInstance().readEventSet();
+
+        k += selected;
+        index += tuplesToProcess;
+
+        performSemiJoinAdaption(useBloomFilter, passRate, static_cast<float>(counterValues[0]) / tableProbes,
+                                tableOutgrowsL2);
+    }
+
+    return k;
+}
+
+template<typename T>
+int semiJoinIndexesHash(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet) {
+    return semiJoinIndexesHashAux<false>(0, n, inputFilter, selection, keySet);
+}
+
+template<typename T>
+int semiJoinIndexesBloom(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet) {
+    int bloomPassed = 0;
+    return semiJoinIndexesBloomAux<false>(0, n, inputFilter, selection, keySet, bloomPassed);
+}
+
+template<typename T>
+int semiJoinIndexesAdaptive(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet) {
+    return semiJoinIndexesAdaptiveAux<false>(n, inputFilter, selection, keySet);
+}
+
+template<typename T>
+int antiJoinIndexesHash(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet) {
+    return semiJoinIndexesHashAux<true>(0, n, inputFilter, selection, keySet);
+}
+
+template<typename T>
+int antiJoinIndexesBloom(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet) {
+    int bloomPassed = 0;
+    return semiJoinIndexesBloomAux<true>(0, n, inputFilter, selection, keySet, bloomPassed);
+}
+
+template<typename T>
+int antiJoinIndexesAdaptive(int n, const T *inputFilter, int *selection, const JoinKeySet<T> &keySet) {
+    return semiJoinIndexesAdaptiveAux<true>(n, inputFilter, selection, keySet);
+}
+
+template<typename T>
+int runSemiJoinFunction(SemiJoin semiJoinImplementation, int n, const T *inputFilter, int *selection,
+                        const JoinKeySet<T> &keySet) {
+    switch (semiJoinImplementation) {
+        case SemiJoin::ImplementationSemiJoinHash:
+            return semiJoinIndexesHash(n, inputFilter, selection, keySet);
+        case SemiJoin::ImplementationSemiJoinBloom:
+            return semiJoinIndexesBloom(n, inputFilter, selection, keySet);
+        case SemiJoin::ImplementationSemiJoinAdaptive:
+            return semiJoinIndexesAdaptive(n, inputFilter, selection, keySet);
+        case SemiJoin::ImplementationAntiJoinHash:
+            return antiJoinIndexesHash(n, inputFilter, selection, keySet);
+        case SemiJoin::ImplementationAntiJoinBloom:
+            return antiJoinIndexesBloom(n, inputFilter, selection, keySet);
+        case SemiJoin::ImplementationAntiJoinAdaptive:
+            return antiJoinIndexesAdaptive(n, inputFilter, selection, keySet);
+        default:
+            std::cout << "Invalid selection of 'SemiJoin' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
+
+#endif //MABPL_JOINIMPLEMENTATION_H
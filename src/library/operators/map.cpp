@@ -0,0 +1,36 @@
+#include <iostream>
+
+#include "map.h"
+
+
+namespace MABPL {
+
+std::string getMapRowsName(MapRows mapRows) {
+    switch (mapRows) {
+        case MapRows::MapAllRows:
+            return "Map_AllRows";
+        case MapRows::MapSelectedRows:
+            return "Map_SelectedRows";
+        case MapRows::MapAdaptiveRows:
+            return "Map_AdaptiveRows";
+        default:
+            std::cout << "Invalid selection of 'MapRows' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+std::string getMapOverflowName(MapOverflow mapOverflow) {
+    switch (mapOverflow) {
+        case MapOverflow::MapUnchecked:
+            return "Map_Unchecked";
+        case MapOverflow::MapChecked:
+            return "Map_Checked";
+        case MapOverflow::MapAdaptiveChecking:
+            return "Map_AdaptiveChecking";
+        default:
+            std::cout << "Invalid selection of 'MapOverflow' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
@@ -0,0 +1,64 @@
+#ifndef MABPL_MAP_H
+#define MABPL_MAP_H
+
+#include <string>
+
+
+namespace MABPL {
+
+enum MapRows {
+    MapAllRows,
+    MapSelectedRows,
+    MapAdaptiveRows
+};
+
+enum MapOverflow {
+    MapUnchecked,
+    MapChecked,
+    MapAdaptiveChecking
+};
+
+std::string getMapRowsName(MapRows mapRows);
+
+std::string getMapOverflowName(MapOverflow mapOverflow);
+
+// Column-wise arithmetic. Each operand is either a column of n values or a constant of the output type, and row i of
+// the result is written to output[i]. With a selection vector, e.g. from selectIndexes, only the selected rows must be
+// computed. The values at other rows of output are unspecified, as MapAllRows computes every row of the column with
+// SIMD while MapSelectedRows computes only the selected rows. MapAdaptiveRows picks one of the two every chunk from the
+// fraction of its rows that are selected. A selection of nullptr selects all n rows.
+//
+// Integer overflow in a selected row prints an error and exits unless the overflow is MapUnchecked, in which case the
+// result wraps around. MapChecked checks every row. MapAdaptiveChecking computes a chunk with the unchecked SIMD kernel
+// while taking the range of each operand, and computes it again checked only if some combination of values in those
+// ranges could overflow. The chunks following one that could overflow are checked directly before ranges are tried
+// again. Floating point arithmetic follows IEEE 754 and is never checked.
+template<typename T, typename Left, typename Right>
+void mapAdd(int n, Left left, Right right, T *output, const int *selection = nullptr, int selected = 0,
+            MapRows rows = MapRows::MapAdaptiveRows, MapOverflow overflow = MapOverflow::MapAdaptiveChecking);
+
+template<typename T, typename Left, typename Right>
+void mapSubtract(int n, Left left, Right right, T *output, const int *selection = nullptr, int selected = 0,
+                 MapRows rows = MapRows::MapAdaptiveRows, MapOverflow overflow = MapOverflow::MapAdaptiveChecking);
+
+template<typename T, typename Left, typename Right>
+void mapMultiply(int n, Left left, Right right, T *output, const int *selection = nullptr, int selected = 0,
+                 MapRows rows = MapRows::MapAdaptiveRows, MapOverflow overflow = MapOverflow::MapAdaptiveChecking);
+
+// left * right + addend, rounded once for floating point types
+template<typename T, typename Left, typename Right, typename Addend>
+void mapMultiplyAdd(int n, Left left, Right right, Addend addend, T *output, const int *selection = nullptr,
+                    int selected = 0, MapRows rows = MapRows::MapAdaptiveRows,
+                    MapOverflow overflow = MapOverflow::MapAdaptiveChecking);
+
+// Converts a column to another arithmetic type. Only conversions to an integer type that cannot hold every value of the
+// input type are checked, and floating point values are truncated towards zero.
+template<typename T1, typename T2>
+void mapCast(int n, const T1 *input, T2 *output, const int *selection = nullptr, int selected = 0,
+             MapRows rows = MapRows::MapAdaptiveRows, MapOverflow overflow = MapOverflow::MapAdaptiveChecking);
+
+}
+
+#include "mapImplementation.h"
+
+#endif //MABPL_MAP_H
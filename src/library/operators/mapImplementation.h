@@ -0,0 +1,349 @@
+#ifndef MABPL_MAPIMPLEMENTATION_H
+#define MABPL_MAPIMPLEMENTATION_H
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+
+namespace MABPL {
+
+constexpr int MAP_TUPLES_PER_CHUNK = 4096;
+constexpr float MAP_ALL_ROWS_MIN_SELECTIVITY = 0.3;
+constexpr int MAP_CHECKED_CHUNKS_BEFORE_RANGE_RETRY = 16;
+
+// Unchecked integer arithmetic is carried out on unsigned values of at least the width of an int, so that it wraps
+// around rather than being undefined
+template<typename T, bool = std::is_integral<T>::value>
+struct MapWrap {
+    using type = T;
+};
+
+template<typename T>
+struct MapWrap<T, true> {
+    using type = std::conditional_t<(sizeof(T) < sizeof(unsigned int)), unsigned int, std::make_unsigned_t<T>>;
+};
+
+template<typename T>
+using MapWrapType = typename MapWrap<T>::type;
+
+template<typename T>
+struct MapRange {
+    T lowest;
+    T highest;
+    bool valid;
+};
+
+template<typename T>
+inline const T *mapOperand(const T *column) {
+    return column;
+}
+
+template<typename T, typename Constant, typename = std::enable_if_t<std::is_arithmetic<Constant>::value>>
+inline T mapOperand(Constant constant) {
+    return static_cast<T>(constant);
+}
+
+template<typename T>
+inline T mapValue(const T *column, int i) {
+    return column[i];
+}
+
+template<typename T>
+inline T mapValue(T constant, int) {
+    return constant;
+}
+
+// A NaN leaves the range invalid, so that no cast of it is taken to be safe
+template<typename T>
+inline void mapRangeAux(T value, T &lowest, T &highest, bool &nan) {
+    lowest = value < lowest ? value : lowest;
+    highest = value > highest ? value : highest;
+    if constexpr (std::is_floating_point<T>::value) {
+        nan |= value != value;
+    }
+}
+
+struct MapAddOperation {
+    static constexpr const char *name = "Add";
+
+    template<typename T>
+    static constexpr bool checkable() {
+        return std::is_integral<T>::value;
+    }
+
+    template<typename T>
+    static inline T unchecked(T left, T right) {
+        return static_cast<T>(static_cast<MapWrapType<T>>(left) + static_cast<MapWrapType<T>>(right));
+    }
+
+    template<typename T>
+    static inline bool checked(T &result, T left, T right) {
+        return __builtin_add_overflow(left, right, &result);
+    }
+};
+
+struct MapSubtractOperation {
+    static constexpr const char *name = "Subtract";
+
+    template<typename T>
+    static constexpr bool checkable() {
+        return std::is_integral<T>::value;
+    }
+
+    template<typename T>
+    static inline T unchecked(T left, T right) {
+        return static_cast<T>(static_cast<MapWrapType<T>>(left) - static_cast<MapWrapType<T>>(right));
+    }
+
+    template<typename T>
+    static inline bool checked(T &result, T left, T right) {
+        return __builtin_sub_overflow(left, right, &result);
+    }
+};
+
+struct MapMultiplyOperation {
+    static constexpr const char *name = "Multiply";
+
+    template<typename T>
+    static constexpr bool checkable() {
+        return std::is_integral<T>::value;
+    }
+
+    template<typename T>
+    static inline T unchecked(T left, T right) {
+        return static_cast<T>(static_cast<MapWrapType<T>>(left) * static_cast<MapWrapType<T>>(right));
+    }
+
+    template<typename T>
+    static inline bool checked(T &result, T left, T right) {
+        return __builtin_mul_overflow(left, right, &result);
+    }
+};
+
+struct MapMultiplyAddOperation {
+    static constexpr const char *name = "MultiplyAdd";
+
+    template<typename T>
+    static constexpr bool checkable() {
+        return std::is_integral<T>::value;
+    }
+
+    template<typename T>
+    static inline T unchecked(T left, T right, T addend) {
+        if constexpr (std::is_floating_point<T>::value) {
+            return std::fma(left, right, addend);
+        } else {
+            return static_cast<T>(static_cast<MapWrapType<T>>(left) * static_cast<MapWrapType<T>>(right) +
+                                  static_cast<MapWrapType<T>>(addend));
+        }
+    }
+
+    template<typename T>
+    static inline bool checked(T &result, T left, T right, T addend) {
+        T product;
+        bool overflow = __builtin_mul_overflow(left, right, &product);
+        return __builtin_add_overflow(product, addend, &result) | overflow;
+    }
+};
+
+template<typename T2>
+struct MapCastOperation {
+    static constexpr const char *name = "Cast";
+
+    // Only conversions to an integer type that does not contain the input type can overflow
+    template<typename T1>
+    static constexpr bool checkable() {
+        if constexpr (!std::is_integral<T2>::value) {
+            return false;
+        } else if constexpr (std::is_floating_point<T1>::value) {
+            return true;
+        } else if constexpr (std::is_signed<T1>::value == std::is_signed<T2>::value) {
+            return sizeof(T2) < sizeof(T1);
+        } else {
+            return std::is_signed<T1>::value || sizeof(T2) <= sizeof(T1);
+        }
+    }
+
+    template<typename T1>
+    static inline T2 unchecked(T1 value) {
+        return static_cast<T2>(value);
+    }
+
+    // Floating point values must truncate to within [lowest, 2^digits), both of which are exact in T1
+    template<typename T1>
+    static inline bool checked(T2 &result, T1 value) {
+        if constexpr (std::is_floating_point<T1>::value) {
+            T1 truncated = std::trunc(value);
+            T1 lowest = static_cast<T1>(std::numeric_limits<T2>::lowest());
+            T1 limit = 2 * static_cast<T1>(std::numeric_limits<T2>::max() / 2 + 1);
+            bool overflow = !(truncated >= lowest && truncated < limit);
+            result = overflow ? 0 : static_cast<T2>(truncated);
+            return overflow;
+        } else {
+            return __builtin_add_overflow(value, static_cast<T1>(0), &result);
+        }
+    }
+};
+
+// Computes rows [start, end), or the rows selection[start, end) when selected
+template<bool selected, typename T1, typename T2, typename Operation, typename... Operands>
+void mapUncheckedAux(int start, int end, const int *selection, T2 *output, Operands... operands) {
+    for (int j = start; j < end; j++) {
+        int i = selected ? selection[j] : j;
+        output[i] = Operation::unchecked(mapValue<T1>(operands, i)...);
+    }
+}
+
+// Computes the rows unchecked while taking the range of each operand over them, in the same pass
+template<bool selected, typename T1, typename T2, typename Operation, size_t... Operand, typename... Operands>
+void mapUncheckedRangesAux(int start, int end, const int *selection, T2 *output, MapRange<T1> *ranges,
+                           std::index_sequence<Operand...>, Operands... operands) {
+    T1 lowest[] = {(static_cast<void>(Operand), std::numeric_limits<T1>::max())...};
+    T1 highest[] = {(static_cast<void>(Operand), std::numeric_limits<T1>::lowest())...};
+    bool nan = false;
+    for (int j = start; j < end; j++) {
+        int i = selected ? selection[j] : j;
+        T1 values[] = {mapValue<T1>(operands, i)...};
+        output[i] = Operation::unchecked(values[Operand]...);
+        (mapRangeAux(values[Operand], lowest[Operand], highest[Operand], nan), ...);
+    }
+    ((ranges[Operand] = {lowest[Operand], highest[Operand], !nan}), ...);
+}
+
+// Returns whether any row overflowed
+template<typename T1, typename T2, typename Operation, typename... Operands>
+bool mapCheckedAux(int start, int end, const int *selection, T2 *output, Operands... operands) {
+    bool overflow = false;
+    for (int j = start; j < end; j++) {
+        int i = selection == nullptr ? j : selection[j];
+        overflow |= Operation::checked(output[i], mapValue<T1>(operands, i)...);
+    }
+    return overflow;
+}
+
+// Every operation is linear in each of its operands, so its result and those of its intermediate steps are extreme at
+// corners of the box spanned by the ranges of the operands, and none can overflow if none does at any corner
+template<typename T1, typename T2, typename Operation, size_t... Operand>
+bool mapCornersFit(const MapRange<T1> *ranges, std::index_sequence<Operand...>) {
+    constexpr int operands = sizeof...(Operand);
+    for (int operand = 0; operand < operands; operand++) {
+        if (!ranges[operand].valid) {
+            return false;
+        }
+    }
+    T2 result;
+    for (int corner = 0; corner < (1 << operands); corner++) {
+        if (Operation::checked(result, ((corner >> Operand) & 1 ? ranges[Operand].highest
+                                                                 : ranges[Operand].lowest)...)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T1, typename T2, typename Operation, typename... Operands>
+void mapAux(int n, const int *selection, int selected, T2 *output, MapRows rows, MapOverflow overflow,
+            Operands... operands) {
+    static_assert(std::is_arithmetic<T1>::value && std::is_arithmetic<T2>::value,
+                  "Map columns must be of a numeric type");
+    constexpr bool checkable = Operation::template checkable<T1>();
+    constexpr auto operandIndexes = std::index_sequence_for<Operands...>();
+    int checkedChunks = 0;
+    int selectionEnd = 0;
+
+    for (int start = 0; start < n; start += MAP_TUPLES_PER_CHUNK) {
+        int end = std::min(n, start + MAP_TUPLES_PER_CHUNK);
+        int selectionStart = selectionEnd;
+        if (selection != nullptr) {
+            while (selectionEnd < selected && selection[selectionEnd] < end) {
+                selectionEnd++;
+            }
+            if (selectionEnd == selectionStart) {
+                continue;
+            }
+        }
+
+        bool allRows = selection == nullptr || rows == MapRows::MapAllRows ||
+                       (rows == MapRows::MapAdaptiveRows &&
+                        selectionEnd - selectionStart >= MAP_ALL_ROWS_MIN_SELECTIVITY * (end - start));
+
+        // Chunks that could overflow are checked over the selected rows only, as unselected rows may hold any value
+        if constexpr (checkable) {
+            if (overflow != MapOverflow::MapUnchecked) {
+                bool checkChunk = overflow == MapOverflow::MapChecked || checkedChunks > 0;
+                if (!checkChunk) {
+                    MapRange<T1> ranges[sizeof...(Operands)];
+                    if (allRows) {
+                        mapUncheckedRangesAux<false, T1, T2, Operation>(start, end, nullptr, output, ranges,
+                                                                        operandIndexes, operands...);
+                    } else {
+                        mapUncheckedRangesAux<true, T1, T2, Operation>(selectionStart, selectionEnd, selection,
+                                                                       output, ranges, operandIndexes, operands...);
+                    }
+                    checkChunk = !mapCornersFit<T1, T2, Operation>(ranges, operandIndexes);
+                    checkedChunks = checkChunk ? MAP_CHECKED_CHUNKS_BEFORE_RANGE_RETRY + 1 : 0;
+                }
+                if (checkChunk) {
+                    checkedChunks -= checkedChunks > 0;
+                    bool overflowed = selection == nullptr
+                                      ? mapCheckedAux<T1, T2, Operation>(start, end, nullptr, output, operands...)
+                                      : mapCheckedAux<T1, T2, Operation>(selectionStart, selectionEnd, selection,
+                                                                         output, operands...);
+                    if (overflowed) {
+                        std::cout << "Overflow in map '" << Operation::name << "'!" << std::endl;
+                        exit(1);
+                    }
+                }
+                continue;
+            }
+        }
+
+        if (allRows) {
+            mapUncheckedAux<false, T1, T2, Operation>(start, end, nullptr, output, operands...);
+        } else {
+            mapUncheckedAux<true, T1, T2, Operation>(selectionStart, selectionEnd, selection, output, operands...);
+        }
+    }
+}
+
+template<typename T, typename Left, typename Right>
+void mapAdd(int n, Left left, Right right, T *output, const int *selection, int selected, MapRows rows,
+            MapOverflow overflow) {
+    mapAux<T, T, MapAddOperation>(n, selection, selected, output, rows, overflow, mapOperand<T>(left),
+                                  mapOperand<T>(right));
+}
+
+template<typename T, typename Left, typename Right>
+void mapSubtract(int n, Left left, Right right, T *output, const int *selection, int selected, MapRows rows,
+                 MapOverflow overflow) {
+    mapAux<T, T, MapSubtractOperation>(n, selection, selected, output, rows, overflow, mapOperand<T>(left),
+                                       mapOperand<T>(right));
+}
+
+template<typename T, typename Left, typename Right>
+void mapMultiply(int n, Left left, Right right, T *output, const int *selection, int selected, MapRows rows,
+                 MapOverflow overflow) {
+    mapAux<T, T, MapMultiplyOperation>(n, selection, selected, output, rows, overflow, mapOperand<T>(left),
+                                       mapOperand<T>(right));
+}
+
+template<typename T, typename Left, typename Right, typename Addend>
+void mapMultiplyAdd(int n, Left left, Right right, Addend addend, T *output, const int *selection, int selected,
+                    MapRows rows, MapOverflow overflow) {
+    mapAux<T, T, MapMultiplyAddOperation>(n, selection, selected, output, rows, overflow, mapOperand<T>(left),
+                                          mapOperand<T>(right), mapOperand<T>(addend));
+}
+
+template<typename T1, typename T2>
+void mapCast(int n, const T1 *input, T2 *output, const int *selection, int selected, MapRows rows,
+             MapOverflow overflow) {
+    mapAux<T1, T2, MapCastOperation<T2>>(n, selection, selected, output, rows, overflow, input);
+}
+
+}
+
+#endif //MABPL_MAPIMPLEMENTATION_H
@@ -0,0 +1,28 @@
+#ifndef MABPL_PARTITION_H
+#define MABPL_PARTITION_H
+
+#include <vector>
+
+
+namespace MABPL {
+
+// Scatters n rows of a key column and its payload column into outputKeys and outputPayloads grouped by partition, and
+// returns the offset of each partition followed by n. Rows keep their input order within a partition. partitionRadix
+// partitions on the bits [shift, shift + bits) of each key's offset from minimum, so that partitions are in key order.
+// partitionHash partitions on the top bits of a multiplicative hash of the key. payloads may be nullptr to partition
+// the keys alone. With several threads each histograms and scatters a contiguous range of the input. Write combining
+// gathers a cache line of rows per partition before copying it to the output, which pays off once the fan-out exceeds
+// the TLB and L1.
+template<typename T1, typename T2>
+std::vector<int> partitionRadix(int n, const T1 *keys, const T2 *payloads, T1 *outputKeys, T2 *outputPayloads,
+                                T1 minimum, int shift, int bits, int threads = 1, bool writeCombining = false);
+
+template<typename T1, typename T2>
+std::vector<int> partitionHash(int n, const T1 *keys, const T2 *payloads, T1 *outputKeys, T2 *outputPayloads,
+                               int bits, int threads = 1, bool writeCombining = false);
+
+}
+
+#include "partitionImplementation.h"
+
+#endif //MABPL_PARTITION_H
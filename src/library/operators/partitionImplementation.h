@@ -0,0 +1,210 @@
+#ifndef MABPL_PARTITIONIMPLEMENTATION_H
+#define MABPL_PARTITIONIMPLEMENTATION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "../utilities/memoryArena.h"
+
+
+namespace MABPL {
+
+constexpr int PARTITION_MIN_TUPLES_PER_THREAD = 64 * 1000;
+constexpr int PARTITION_WRITE_COMBINING_BYTES = 64;
+constexpr uint64_t PARTITION_HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+template<typename T>
+struct RadixKey {
+    using type = std::make_unsigned_t<T>;
+};
+
+template<>
+struct RadixKey<unsigned __int128> {
+    using type = unsigned __int128;
+};
+
+// Radix passes partition the offset of each key from the minimum key, so that signed keys partition in order and
+// leading bits shared by every key are never partitioned on
+template<typename T>
+inline typename RadixKey<T>::type radixOffset(T key, T minimum) {
+    return static_cast<typename RadixKey<T>::type>(key) - static_cast<typename RadixKey<T>::type>(minimum);
+}
+
+template<typename T>
+inline int radixBucket(T key, T minimum, int shift, int mask) {
+    return static_cast<int>((radixOffset(key, minimum) >> shift) & mask);
+}
+
+// Fibonacci hashing, whose top bits are well mixed
+template<typename T>
+inline int hashPartition(T key, int bits) {
+    return bits == 0 ? 0 : static_cast<int>((static_cast<uint64_t>(key) * PARTITION_HASH_MULTIPLIER) >> (64 - bits));
+}
+
+template<typename T1, typename PartitionOf>
+inline void partitionCount(int start, int end, const T1 *keys, const PartitionOf &partitionOf, int *counts) {
+    for (int i = start; i < end; i++) {
+        counts[partitionOf(keys[i])]++;
+    }
+}
+
+// Each row is written to the next position of its partition, which positions holds and advances
+template<typename T1, typename T2, typename PartitionOf>
+inline void partitionScatter(int start, int end, const T1 *keys, const T2 *payloads, T1 *outputKeys,
+                             T2 *outputPayloads, const PartitionOf &partitionOf, int *positions) {
+    int i;
+    if (payloads == nullptr) {
+        for (i = start; i < end; i++) {
+            outputKeys[positions[partitionOf(keys[i])]++] = keys[i];
+        }
+        return;
+    }
+    for (i = start; i < end; i++) {
+        int position = positions[partitionOf(keys[i])]++;
+        outputKeys[position] = keys[i];
+        outputPayloads[position] = payloads[i];
+    }
+}
+
+template<typename T1>
+constexpr int partitionRowsPerLine() {
+    return std::max(1, static_cast<int>(PARTITION_WRITE_COMBINING_BYTES / sizeof(T1)));
+}
+
+// Rows are gathered a cache line of keys at a time per partition, so the scatter touches one line of output per
+// partition only when a full line is copied out. The line buffers hold partitionRowsPerLine rows per partition and are
+// passed in, as worker threads must not allocate from their own arenas.
+template<typename T1, typename T2, typename PartitionOf>
+void partitionScatterWriteCombining(int start, int end, const T1 *keys, const T2 *payloads, T1 *outputKeys,
+                                    T2 *outputPayloads, int numPartitions, const PartitionOf &partitionOf,
+                                    int *positions, T1 *lineKeys, T2 *linePayloads, int *lineRows) {
+    constexpr int rowsPerLine = partitionRowsPerLine<T1>();
+    std::fill(lineRows, lineRows + numPartitions, 0);
+
+    int partition;
+    for (int i = start; i < end; i++) {
+        partition = partitionOf(keys[i]);
+        int slot = partition * rowsPerLine + lineRows[partition];
+        lineKeys[slot] = keys[i];
+        if (payloads != nullptr) {
+            linePayloads[slot] = payloads[i];
+        }
+        if (++lineRows[partition] == rowsPerLine) {
+            std::copy(lineKeys + partition * rowsPerLine, lineKeys + slot + 1, outputKeys + positions[partition]);
+            if (payloads != nullptr) {
+                std::copy(linePayloads + partition * rowsPerLine, linePayloads + slot + 1,
+                          outputPayloads + positions[partition]);
+            }
+            positions[partition] += rowsPerLine;
+            lineRows[partition] = 0;
+        }
+    }
+
+    for (partition = 0; partition < numPartitions; partition++) {
+        int lineStart = partition * rowsPerLine;
+        std::copy(lineKeys + lineStart, lineKeys + lineStart + lineRows[partition], outputKeys + positions[partition]);
+        if (payloads != nullptr) {
+            std::copy(linePayloads + lineStart, linePayloads + lineStart + lineRows[partition],
+                      outputPayloads + positions[partition]);
+        }
+        positions[partition] += lineRows[partition];
+    }
+}
+
+template<typename Work>
+inline void partitionRunThreads(int threads, const Work &work) {
+    if (threads == 1) {
+        work(0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int thread = 0; thread < threads; thread++) {
+        workers.emplace_back([&work, thread] { work(thread); });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+// Partitions rows [start, end) into the same range of the outputs and writes the start of each of the numPartitions
+// partitions to offsets, followed by end. Threads histogram their own range, and the prefix sum over partitions and
+// then threads gives each thread its own positions within every partition.
+template<typename T1, typename T2, typename PartitionOf>
+void partitionAux(int start, int end, const T1 *keys, const T2 *payloads, T1 *outputKeys, T2 *outputPayloads,
+                  int numPartitions, const PartitionOf &partitionOf, int *offsets, int threads = 1,
+                  bool writeCombining = false) {
+    threads = std::max(1, std::min(threads, (end - start) / PARTITION_MIN_TUPLES_PER_THREAD));
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    int *counts = arena.allocate<int>(threads * numPartitions);
+    int *positions = arena.allocate<int>(threads * numPartitions);
+    std::fill(counts, counts + threads * numPartitions, 0);
+
+    auto threadStart = [start, end, threads](int thread) {
+        return start + static_cast<int>(static_cast<long>(end - start) * thread / threads);
+    };
+
+    partitionRunThreads(threads, [&](int thread) {
+        partitionCount(threadStart(thread), threadStart(thread + 1), keys, partitionOf,
+                       counts + thread * numPartitions);
+    });
+
+    int offset = start;
+    for (int partition = 0; partition < numPartitions; partition++) {
+        offsets[partition] = offset;
+        for (int thread = 0; thread < threads; thread++) {
+            positions[thread * numPartitions + partition] = offset;
+            offset += counts[thread * numPartitions + partition];
+        }
+    }
+    offsets[numPartitions] = end;
+
+    // Line buffers for every thread come from the calling thread's arena
+    int lineSlots = numPartitions * partitionRowsPerLine<T1>();
+    T1 *lineKeys = writeCombining ? arena.allocate<T1>(threads * lineSlots) : nullptr;
+    T2 *linePayloads = writeCombining && payloads != nullptr ? arena.allocate<T2>(threads * lineSlots) : nullptr;
+    int *lineRows = writeCombining ? arena.allocate<int>(threads * numPartitions) : nullptr;
+
+    partitionRunThreads(threads, [&](int thread) {
+        if (writeCombining) {
+            partitionScatterWriteCombining(threadStart(thread), threadStart(thread + 1), keys, payloads, outputKeys,
+                                           outputPayloads, numPartitions, partitionOf,
+                                           positions + thread * numPartitions, lineKeys + thread * lineSlots,
+                                           linePayloads != nullptr ? linePayloads + thread * lineSlots : nullptr,
+                                           lineRows + thread * numPartitions);
+        } else {
+            partitionScatter(threadStart(thread), threadStart(thread + 1), keys, payloads, outputKeys,
+                             outputPayloads, partitionOf, positions + thread * numPartitions);
+        }
+    });
+
+    arena.rewind(arenaMark);
+}
+
+template<typename T1, typename T2>
+std::vector<int> partitionRadix(int n, const T1 *keys, const T2 *payloads, T1 *outputKeys, T2 *outputPayloads,
+                                T1 minimum, int shift, int bits, int threads, bool writeCombining) {
+    int mask = (1 << bits) - 1;
+    std::vector<int> offsets((1 << bits) + 1);
+    partitionAux(0, n, keys, payloads, outputKeys, outputPayloads, 1 << bits,
+                 [minimum, shift, mask](T1 key) { return radixBucket(key, minimum, shift, mask); }, offsets.data(),
+                 threads, writeCombining);
+    return offsets;
+}
+
+template<typename T1, typename T2>
+std::vector<int> partitionHash(int n, const T1 *keys, const T2 *payloads, T1 *outputKeys, T2 *outputPayloads,
+                               int bits, int threads, bool writeCombining) {
+    std::vector<int> offsets((1 << bits) + 1);
+    partitionAux(0, n, keys, payloads, outputKeys, outputPayloads, 1 << bits,
+                 [bits](T1 key) { return hashPartition(key, bits); }, offsets.data(), threads, writeCombining);
+    return offsets;
+}
+
+}
+
+#endif //MABPL_PARTITIONIMPLEMENTATION_H
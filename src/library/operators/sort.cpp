@@ -0,0 +1,26 @@
+#include <iostream>
+
+#include "sort.h"
+
+
+namespace MABPL {
+
+std::string getSortName(SortAlgorithm sortImplementation) {
+    switch (sortImplementation) {
+        case SortAlgorithm::SortLsbRadix:
+            return "Sort_LsbRadix";
+        case SortAlgorithm::SortMsbRadix:
+            return "Sort_MsbRadix";
+        case SortAlgorithm::SortComparison:
+            return "Sort_Comparison";
+        case SortAlgorithm::SortRunMerge:
+            return "Sort_RunMerge";
+        case SortAlgorithm::SortAdaptive:
+            return "Sort_Adaptive";
+        default:
+            std::cout << "Invalid selection of 'Sort' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
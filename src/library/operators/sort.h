@@ -0,0 +1,47 @@
+#ifndef MABPL_SORT_H
+#define MABPL_SORT_H
+
+#include <string>
+
+
+namespace MABPL {
+
+enum SortAlgorithm {
+    SortLsbRadix,
+    SortMsbRadix,
+    SortComparison,
+    SortRunMerge,
+    SortAdaptive
+};
+
+std::string getSortName(SortAlgorithm sortImplementation);
+
+// Sorts the rows of an integer key column and its payload column in place by key. Rows with equal keys are left in no
+// particular order. sortLsbRadix makes one scatter pass per radix digit of the key range from the lowest digit up and
+// sortMsbRadix partitions from the highest digit down, finishing small partitions with sortComparison. sortRunMerge
+// merges the ascending runs already present in the input. sortAdaptive surveys the input a chunk at a time for its key
+// range and runs and either radix sorts the whole input or sorts each chunk with the cheapest of the above and merges
+// the chunks, whichever needs the fewest passes over the data.
+template<typename T1, typename T2>
+void sortLsbRadix(int n, T1 *keys, T2 *payloads);
+
+template<typename T1, typename T2>
+void sortMsbRadix(int n, T1 *keys, T2 *payloads);
+
+template<typename T1, typename T2>
+void sortComparison(int n, T1 *keys, T2 *payloads);
+
+template<typename T1, typename T2>
+void sortRunMerge(int n, T1 *keys, T2 *payloads);
+
+template<typename T1, typename T2>
+void sortAdaptive(int n, T1 *keys, T2 *payloads);
+
+template<typename T1, typename T2>
+void runSortFunction(SortAlgorithm sortImplementation, int n, T1 *keys, T2 *payloads);
+
+}
+
+#include "sortImplementation.h"
+
+#endif //MABPL_SORT_H
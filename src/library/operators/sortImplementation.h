@@ -0,0 +1,443 @@
+#ifndef MABPL_SORTIMPLEMENTATION_H
+#define MABPL_SORTIMPLEMENTATION_H
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <utility>
+
+#include "groupBy.h"
+#include "../utilities/systemInformation.h"
+#include "../utilities/memoryArena.h"
+
+
+namespace MABPL {
+
+constexpr int SORT_INSERTION_MAX_TUPLES = 32;
+constexpr int SORT_COMPARISON_MAX_TUPLES = 1024;
+constexpr int SORT_LSB_MAX_PASSES = 2;
+constexpr float SORT_CHUNK_L2_FRACTION = 0.5;
+constexpr int SORT_MIN_TUPLES_PER_CHUNK = 4096;
+
+template<typename T1, typename T2>
+struct SortEntry {
+    T1 key;
+    T2 payload;
+};
+
+template<typename T>
+struct SortChunkSurvey {
+    int start;
+    int end;
+    T smallest;
+    T largest;
+    int runs;
+};
+
+// Radix digits of the key offsets, pass 0 being the lowest. The bits of the key range are spread evenly over the fewest
+// passes whose fan-out stays within radixPartitionBits, and a range of one key needs no passes.
+template<typename T>
+inline RadixPasses sortRadixPasses(T smallest, T largest) {
+    auto range = radixOffset(largest, smallest);
+    int keyBits = 0;
+    while (range != 0) {
+        range >>= 1;
+        keyBits++;
+    }
+
+    int partitionBits = radixPartitionBits();
+    RadixPasses passes{};
+    passes.count = (keyBits + partitionBits - 1) / partitionBits;
+    passes.maxBuckets = 1;
+    int remainingBits = keyBits;
+    for (int pass = 0; pass < passes.count; pass++) {
+        int passesLeft = passes.count - pass;
+        passes.shift[pass] = pass == 0 ? 0 : passes.shift[pass - 1] + passes.bits[pass - 1];
+        passes.bits[pass] = (remainingBits + passesLeft - 1) / passesLeft;
+        remainingBits -= passes.bits[pass];
+        passes.maxBuckets = std::max(passes.maxBuckets, passes.numBuckets(pass));
+    }
+    return passes;
+}
+
+// Pairwise merging halves the number of runs with every pass over the data
+inline int sortMergePasses(long runs) {
+    int passes = 0;
+    while ((1L << passes) < runs) {
+        passes++;
+    }
+    return passes;
+}
+
+// A chunk and its scratch copy fill a fraction of L2
+template<typename T1, typename T2>
+inline int sortTuplesPerChunk() {
+    static const int tuples = [] {
+        long l2Bytes = l2cacheSize() > 0 ? l2cacheSize() : 256 * 1024;
+        auto chunkBytes = static_cast<long>(SORT_CHUNK_L2_FRACTION * l2Bytes);
+        auto chunkTuples = chunkBytes / static_cast<long>(2 * (sizeof(T1) + sizeof(T2)));
+        return static_cast<int>(std::max(static_cast<long>(SORT_MIN_TUPLES_PER_CHUNK), chunkTuples));
+    }();
+    return tuples;
+}
+
+template<typename T1, typename T2>
+inline void sortInsertionAux(int start, int end, T1 *keys, T2 *payloads) {
+    for (int i = start + 1; i < end; i++) {
+        T1 key = keys[i];
+        T2 payload = payloads[i];
+        int j = i;
+        while (j > start && key < keys[j - 1]) {
+            keys[j] = keys[j - 1];
+            payloads[j] = payloads[j - 1];
+            j--;
+        }
+        keys[j] = key;
+        payloads[j] = payload;
+    }
+}
+
+// Rows are sorted as key and payload pairs so that each comparison moves both columns together
+template<typename T1, typename T2>
+void sortComparisonAux(int start, int end, T1 *keys, T2 *payloads) {
+    if (end - start <= SORT_INSERTION_MAX_TUPLES) {
+        sortInsertionAux(start, end, keys, payloads);
+        return;
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    auto *entries = arena.allocate<SortEntry<T1, T2>>(end - start);
+    for (int i = start; i < end; i++) {
+        entries[i - start] = {keys[i], payloads[i]};
+    }
+    std::sort(entries, entries + (end - start),
+              [](const SortEntry<T1, T2> &a, const SortEntry<T1, T2> &b) { return a.key < b.key; });
+    for (int i = start; i < end; i++) {
+        keys[i] = entries[i - start].key;
+        payloads[i] = entries[i - start].payload;
+    }
+    arena.rewind(arenaMark);
+}
+
+template<typename T1, typename T2>
+inline void sortMergeAux(int start, int middle, int end, const T1 *keys, const T2 *payloads, T1 *outputKeys,
+                         T2 *outputPayloads) {
+    int left = start;
+    int right = middle;
+    int index = start;
+    while (left < middle && right < end) {
+        bool takeRight = keys[right] < keys[left];
+        outputKeys[index] = takeRight ? keys[right] : keys[left];
+        outputPayloads[index] = takeRight ? payloads[right] : payloads[left];
+        left += !takeRight;
+        right += takeRight;
+        index++;
+    }
+    std::copy(keys + left, keys + middle, outputKeys + index);
+    std::copy(payloads + left, payloads + middle, outputPayloads + index);
+    index += middle - left;
+    std::copy(keys + right, keys + end, outputKeys + index);
+    std::copy(payloads + right, payloads + end, outputPayloads + index);
+}
+
+// Merges the sorted runs beginning at runStarts, the last ending at end, pairwise until one run is left. Each pass moves
+// the rows between the input and the scratch columns and the result is left in the input columns.
+template<typename T1, typename T2>
+void sortMergeRunsAux(std::vector<int> &runStarts, int end, T1 *keys, T2 *payloads, T1 *scratchKeys,
+                      T2 *scratchPayloads) {
+    int start = runStarts.front();
+    T1 *sourceKeys = keys;
+    T2 *sourcePayloads = payloads;
+    T1 *destinationKeys = scratchKeys;
+    T2 *destinationPayloads = scratchPayloads;
+
+    while (runStarts.size() > 1) {
+        size_t mergedRuns = 0;
+        for (size_t run = 0; run < runStarts.size(); run += 2) {
+            int middle = run + 1 < runStarts.size() ? runStarts[run + 1] : end;
+            int runEnd = run + 2 < runStarts.size() ? runStarts[run + 2] : end;
+            sortMergeAux(runStarts[run], middle, runEnd, sourceKeys, sourcePayloads, destinationKeys,
+                         destinationPayloads);
+            runStarts[mergedRuns++] = runStarts[run];
+        }
+        runStarts.resize(mergedRuns);
+        std::swap(sourceKeys, destinationKeys);
+        std::swap(sourcePayloads, destinationPayloads);
+    }
+
+    if (sourceKeys != keys) {
+        std::copy(sourceKeys + start, sourceKeys + end, keys + start);
+        std::copy(sourcePayloads + start, sourcePayloads + end, payloads + start);
+    }
+}
+
+template<typename T1, typename T2>
+void sortRunMergeAux(int start, int end, T1 *keys, T2 *payloads, T1 *scratchKeys, T2 *scratchPayloads) {
+    std::vector<int> runStarts = {start};
+    for (int i = start + 1; i < end; i++) {
+        if (keys[i] < keys[i - 1]) {
+            runStarts.push_back(i);
+        }
+    }
+    sortMergeRunsAux(runStarts, end, keys, payloads, scratchKeys, scratchPayloads);
+}
+
+// The histograms of every digit are built in one read of the input. A digit on which all keys agree leaves the order
+// unchanged and its pass is skipped.
+template<typename T1, typename T2>
+void sortLsbRadixAux(int start, int end, T1 *keys, T2 *payloads, T1 *scratchKeys, T2 *scratchPayloads, T1 minimum,
+                     const RadixPasses &passes) {
+    if (passes.count == 0) {
+        return;
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    int *counts = arena.allocate<int>(passes.count * passes.maxBuckets);
+    std::fill(counts, counts + passes.count * passes.maxBuckets, 0);
+    for (int i = start; i < end; i++) {
+        for (int pass = 0; pass < passes.count; pass++) {
+            counts[pass * passes.maxBuckets + radixBucket(keys[i], minimum, passes.shift[pass], passes.mask(pass))]++;
+        }
+    }
+
+    T1 *sourceKeys = keys;
+    T2 *sourcePayloads = payloads;
+    T1 *destinationKeys = scratchKeys;
+    T2 *destinationPayloads = scratchPayloads;
+    for (int pass = 0; pass < passes.count; pass++) {
+        int shift = passes.shift[pass];
+        int mask = passes.mask(pass);
+        int *offsets = counts + pass * passes.maxBuckets;
+        if (offsets[radixBucket(sourceKeys[start], minimum, shift, mask)] == end - start) {
+            continue;
+        }
+
+        int offset = start;
+        for (int bucket = 0; bucket < passes.numBuckets(pass); bucket++) {
+            int count = offsets[bucket];
+            offsets[bucket] = offset;
+            offset += count;
+        }
+        for (int i = start; i < end; i++) {
+            int index = offsets[radixBucket(sourceKeys[i], minimum, shift, mask)]++;
+            destinationKeys[index] = sourceKeys[i];
+            destinationPayloads[index] = sourcePayloads[i];
+        }
+        std::swap(sourceKeys, destinationKeys);
+        std::swap(sourcePayloads, destinationPayloads);
+    }
+
+    if (sourceKeys != keys) {
+        std::copy(sourceKeys + start, sourceKeys + end, keys + start);
+        std::copy(sourcePayloads + start, sourcePayloads + end, payloads + start);
+    }
+    arena.rewind(arenaMark);
+}
+
+// Partitions the rows in keys on the digit of the pass into otherKeys and recurses into each partition with the two
+// column pairs swapped, so that rows move once per level. Small partitions are finished by comparison sort. The sorted
+// rows are left in otherKeys when resultInOther is set and in keys otherwise. A digit on which all keys agree still
+// costs a pass. The LSB sort keeps its own scatter, as it builds the histograms of every digit in one read.
+template<typename T1, typename T2>
+void sortMsbRadixAux(int start, int end, T1 *keys, T2 *payloads, T1 *otherKeys, T2 *otherPayloads,
+                     bool resultInOther, T1 minimum, const RadixPasses &passes, int pass) {
+    if (end - start <= SORT_COMPARISON_MAX_TUPLES || pass < 0) {
+        if (pass >= 0) {
+            sortComparisonAux(start, end, keys, payloads);
+        }
+        if (resultInOther) {
+            std::copy(keys + start, keys + end, otherKeys + start);
+            std::copy(payloads + start, payloads + end, otherPayloads + start);
+        }
+        return;
+    }
+
+    int shift = passes.shift[pass];
+    int mask = passes.mask(pass);
+    int numBuckets = passes.numBuckets(pass);
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    int *bucketStarts = arena.allocate<int>(numBuckets + 1);
+    partitionAux(start, end, keys, payloads, otherKeys, otherPayloads, numBuckets,
+                 [minimum, shift, mask](T1 key) { return radixBucket(key, minimum, shift, mask); }, bucketStarts);
+
+    for (int bucket = 0; bucket < numBuckets; bucket++) {
+        if (bucketStarts[bucket + 1] > bucketStarts[bucket]) {
+            sortMsbRadixAux(bucketStarts[bucket], bucketStarts[bucket + 1], otherKeys, otherPayloads, keys, payloads,
+                            !resultInOther, minimum, passes, pass - 1);
+        }
+    }
+    arena.rewind(arenaMark);
+}
+
+// Passes over a surveyed chunk of the cheapest strategy for it
+template<typename T>
+inline int sortChunkPasses(const SortChunkSurvey<T> &chunk) {
+    if (chunk.runs == 1) {
+        return 0;
+    }
+    return std::min(sortMergePasses(chunk.runs), sortRadixPasses(chunk.smallest, chunk.largest).count);
+}
+
+template<typename T1, typename T2>
+void sortChunkAux(const SortChunkSurvey<T1> &chunk, T1 *keys, T2 *payloads, T1 *scratchKeys, T2 *scratchPayloads) {
+    if (chunk.runs == 1) {
+        return;
+    }
+    RadixPasses passes = sortRadixPasses(chunk.smallest, chunk.largest);
+    if (sortMergePasses(chunk.runs) < passes.count) {
+        sortRunMergeAux(chunk.start, chunk.end, keys, payloads, scratchKeys, scratchPayloads);
+    } else if (passes.count <= SORT_LSB_MAX_PASSES) {
+        sortLsbRadixAux(chunk.start, chunk.end, keys, payloads, scratchKeys, scratchPayloads, chunk.smallest, passes);
+    } else {
+        sortMsbRadixAux(chunk.start, chunk.end, keys, payloads, scratchKeys, scratchPayloads, false, chunk.smallest,
+                        passes, passes.count - 1);
+    }
+}
+
+template<typename T1, typename T2>
+void sortLsbRadix(int n, T1 *keys, T2 *payloads) {
+    static_assert(isGroupByKeyType<T1>, "Sort keys must be an integer type");
+    if (n <= 1) {
+        return;
+    }
+    T1 smallest = keys[0];
+    T1 largest = keys[0];
+    keyRange(n, keys, smallest, largest);
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *scratchKeys = arena.allocate<T1>(n);
+    T2 *scratchPayloads = arena.allocate<T2>(n);
+    sortLsbRadixAux(0, n, keys, payloads, scratchKeys, scratchPayloads, smallest, sortRadixPasses(smallest, largest));
+    arena.rewind(arenaMark);
+}
+
+template<typename T1, typename T2>
+void sortMsbRadix(int n, T1 *keys, T2 *payloads) {
+    static_assert(isGroupByKeyType<T1>, "Sort keys must be an integer type");
+    if (n <= 1) {
+        return;
+    }
+    T1 smallest = keys[0];
+    T1 largest = keys[0];
+    keyRange(n, keys, smallest, largest);
+    RadixPasses passes = sortRadixPasses(smallest, largest);
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *scratchKeys = arena.allocate<T1>(n);
+    T2 *scratchPayloads = arena.allocate<T2>(n);
+    sortMsbRadixAux(0, n, keys, payloads, scratchKeys, scratchPayloads, false, smallest, passes, passes.count - 1);
+    arena.rewind(arenaMark);
+}
+
+template<typename T1, typename T2>
+void sortComparison(int n, T1 *keys, T2 *payloads) {
+    sortComparisonAux(0, n, keys, payloads);
+}
+
+template<typename T1, typename T2>
+void sortRunMerge(int n, T1 *keys, T2 *payloads) {
+    if (n <= 1) {
+        return;
+    }
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *scratchKeys = arena.allocate<T1>(n);
+    T2 *scratchPayloads = arena.allocate<T2>(n);
+    sortRunMergeAux(0, n, keys, payloads, scratchKeys, scratchPayloads);
+    arena.rewind(arenaMark);
+}
+
+// Each chunk is surveyed for its key range and the number of ascending runs it holds. Sorting the chunks separately
+// costs the cheapest strategy of each chunk plus the passes merging them, where neighbouring chunks already in order
+// need no merge. Otherwise the whole input is radix sorted, LSB first while the key range takes few digits.
+template<typename T1, typename T2>
+void sortAdaptive(int n, T1 *keys, T2 *payloads) {
+    static_assert(isGroupByKeyType<T1>, "Sort keys must be an integer type");
+    if (n <= SORT_COMPARISON_MAX_TUPLES) {
+        sortComparisonAux(0, n, keys, payloads);
+        return;
+    }
+
+    int tuplesPerChunk = sortTuplesPerChunk<T1, T2>();
+    std::vector<SortChunkSurvey<T1>> chunks;
+    T1 smallest = keys[0];
+    T1 largest = keys[0];
+    float chunkedPasses = 0;
+    long mergeRuns = 0;
+    for (int start = 0; start < n; start += tuplesPerChunk) {
+        int end = std::min(n, start + tuplesPerChunk);
+        SortChunkSurvey<T1> chunk{start, end, keys[start], keys[start], 1};
+        keyRange(end - start, keys + start, chunk.smallest, chunk.largest);
+        for (int i = start + 1; i < end; i++) {
+            chunk.runs += keys[i] < keys[i - 1];
+        }
+        smallest = std::min(smallest, chunk.smallest);
+        largest = std::max(largest, chunk.largest);
+
+        chunkedPasses += static_cast<float>(sortChunkPasses(chunk)) * static_cast<float>(end - start) /
+                         static_cast<float>(n);
+        mergeRuns += chunks.empty() || chunks.back().largest > chunk.smallest;
+        chunks.push_back(chunk);
+    }
+    chunkedPasses += static_cast<float>(sortMergePasses(mergeRuns));
+
+    RadixPasses passes = sortRadixPasses(smallest, largest);
+    if (passes.count == 0) {
+        return;
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    T1 *scratchKeys = arena.allocate<T1>(n);
+    T2 *scratchPayloads = arena.allocate<T2>(n);
+
+    if (chunkedPasses < static_cast<float>(passes.count)) {
+        std::vector<int> runStarts;
+        for (size_t i = 0; i < chunks.size(); i++) {
+            sortChunkAux(chunks[i], keys, payloads, scratchKeys, scratchPayloads);
+            if (i == 0 || chunks[i - 1].largest > chunks[i].smallest) {
+                runStarts.push_back(chunks[i].start);
+            }
+        }
+        sortMergeRunsAux(runStarts, n, keys, payloads, scratchKeys, scratchPayloads);
+    } else if (passes.count <= SORT_LSB_MAX_PASSES) {
+        sortLsbRadixAux(0, n, keys, payloads, scratchKeys, scratchPayloads, smallest, passes);
+    } else {
+        sortMsbRadixAux(0, n, keys, payloads, scratchKeys, scratchPayloads, false, smallest, passes, passes.count - 1);
+    }
+    arena.rewind(arenaMark);
+}
+
+template<typename T1, typename T2>
+void runSortFunction(SortAlgorithm sortImplementation, int n, T1 *keys, T2 *payloads) {
+    switch (sortImplementation) {
+        case SortAlgorithm::SortLsbRadix:
+            sortLsbRadix(n, keys, payloads);
+            return;
+        case SortAlgorithm::SortMsbRadix:
+            sortMsbRadix(n, keys, payloads);
+            return;
+        case SortAlgorithm::SortComparison:
+            sortComparison(n, keys, payloads);
+            return;
+        case SortAlgorithm::SortRunMerge:
+            sortRunMerge(n, keys, payloads);
+            return;
+        case SortAlgorithm::SortAdaptive:
+            sortAdaptive(n, keys, payloads);
+            return;
+        default:
+            std::cout << "Invalid selection of 'Sort' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
+
+#endif //MABPL_SORTIMPLEMENTATION_H
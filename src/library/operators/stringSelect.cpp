@@ -0,0 +1,22 @@
+#include <iostream>
+
+#include "stringSelect.h"
+
+
+namespace MABPL {
+
+std::string getStringSelectName(StringSelect stringSelectImplementation) {
+    switch (stringSelectImplementation) {
+        case StringSelect::StringSelectBranch:
+            return "StringSelect_Branch";
+        case StringSelect::StringSelectPredication:
+            return "StringSelect_Predication";
+        case StringSelect::StringSelectAdaptive:
+            return "StringSelect_Adaptive";
+        default:
+            std::cout << "Invalid selection of 'StringSelect' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
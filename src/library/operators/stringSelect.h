@@ -0,0 +1,65 @@
+#ifndef MABPL_STRINGSELECT_H
+#define MABPL_STRINGSELECT_H
+
+#include <string>
+
+
+namespace MABPL {
+
+enum StringSelect {
+    StringSelectBranch,
+    StringSelectPredication,
+    StringSelectAdaptive
+};
+
+std::string getStringSelectName(StringSelect stringSelectImplementation);
+
+// Row i holds the width bytes at data + i * width, right padded with '\0' bytes as in a CHAR(width) column
+struct FixedWidthStrings {
+    const char *data;
+    int width;
+};
+
+// Row i holds the bytes data[offsets[i], offsets[i + 1]), so offsets has one more entry than there are rows
+struct VariableWidthStrings {
+    const int *offsets;
+    const char *data;
+};
+
+enum StringPredicateType {
+    StringEqual,
+    StringPrefix,
+    StringBetween
+};
+
+// Rows equal to value, starting with value, or from value up to upper inclusive. Strings compare as unsigned bytes, and
+// a fixed width row equals a shorter value padded with '\0' bytes.
+struct StringPredicate {
+    StringPredicateType type;
+    std::string value;
+    std::string upper;
+};
+
+// Writes the indexes of the rows of a FixedWidthStrings or VariableWidthStrings column satisfying the predicate to
+// selection and returns their number, like selectIndexes. Rows are compared with the predicate a vector of bytes at a
+// time. selectStringIndexesAdaptive switches between the branch and predication loops on the branch misses of each
+// chunk as selectIndexesAdaptive does.
+template<typename Strings>
+int selectStringIndexesBranch(int n, const Strings &inputFilter, const StringPredicate &predicate, int *selection);
+
+template<typename Strings>
+int selectStringIndexesPredication(int n, const Strings &inputFilter, const StringPredicate &predicate,
+                                   int *selection);
+
+template<typename Strings>
+int selectStringIndexesAdaptive(int n, const Strings &inputFilter, const StringPredicate &predicate, int *selection);
+
+template<typename Strings>
+int runStringSelectFunction(StringSelect stringSelectImplementation, int n, const Strings &inputFilter,
+                            const StringPredicate &predicate, int *selection);
+
+}
+
+#include "stringSelectImplementation.h"
+
+#endif //MABPL_STRINGSELECT_H
@@ -0,0 +1,305 @@
+#ifndef MABPL_STRINGSELECTIMPLEMENTATION_H
+#define MABPL_STRINGSELECTIMPLEMENTATION_H
+
+#include <immintrin.h>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+
+#include "select.h"
+#include "../utilities/papi.h"
+
+
+namespace MABPL {
+
+#ifdef __AVX2__
+constexpr int STRING_SIMD_BYTES = 32;
+#else
+constexpr int STRING_SIMD_BYTES = 16;
+#endif
+
+inline long stringBlockBytes(int length) {
+    return (static_cast<long>(length) + STRING_SIMD_BYTES - 1) / STRING_SIMD_BYTES * STRING_SIMD_BYTES;
+}
+
+// Index of the first of the first length bytes at which a and b differ, or length if there is none. When readable,
+// whole vectors of bytes are compared, so stringBlockBytes(length) bytes must be readable at both a and b.
+inline int stringMismatch(const char *a, const char *b, int length, bool readable) {
+    int i = 0;
+    if (readable) {
+        for (; i < length; i += STRING_SIMD_BYTES) {
+#ifdef __AVX2__
+            auto differ = ~static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                    _mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i)))));
+#else
+            auto differ = ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                    _mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i))))) & 0xFFFF;
+#endif
+            if (differ != 0) {
+                return std::min(i + __builtin_ctz(differ), length);
+            }
+        }
+        return length;
+    }
+    while (i < length && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+// Negative, zero or positive as the row orders before, equal to or after the value
+inline int stringCompare(const char *row, int rowLength, const char *value, int length, bool readable) {
+    int common = std::min(rowLength, length);
+    int i = stringMismatch(row, value, common, readable);
+    if (i < common) {
+        return static_cast<unsigned char>(row[i]) - static_cast<unsigned char>(value[i]);
+    }
+    return rowLength - length;
+}
+
+inline long stringRowStart(const FixedWidthStrings &strings, int i) {
+    return static_cast<long>(i) * strings.width;
+}
+
+inline int stringRowLength(const FixedWidthStrings &strings, int) {
+    return strings.width;
+}
+
+inline long stringBytes(const FixedWidthStrings &strings, int n) {
+    return static_cast<long>(n) * strings.width;
+}
+
+// Values compared whole against fixed width rows are padded to the width, as the rows are
+inline int stringPaddedLength(const FixedWidthStrings &strings) {
+    return strings.width;
+}
+
+inline long stringRowStart(const VariableWidthStrings &strings, int i) {
+    return strings.offsets[i];
+}
+
+inline int stringRowLength(const VariableWidthStrings &strings, int i) {
+    return strings.offsets[i + 1] - strings.offsets[i];
+}
+
+inline long stringBytes(const VariableWidthStrings &strings, int n) {
+    return strings.offsets[n];
+}
+
+inline int stringPaddedLength(const VariableWidthStrings &) {
+    return 0;
+}
+
+// A predicate value right padded with '\0' bytes to paddedLength, followed by a vector of '\0' bytes so that it can
+// always be compared a vector at a time
+struct StringConstant {
+    std::vector<char> bytes;
+    int length;
+};
+
+inline StringConstant stringConstant(const std::string &value, int paddedLength) {
+    int length = std::max(static_cast<int>(value.size()), paddedLength);
+    StringConstant constant{std::vector<char>(stringBlockBytes(length) + STRING_SIMD_BYTES, '\0'), length};
+    std::copy(value.begin(), value.end(), constant.bytes.begin());
+    return constant;
+}
+
+struct StringEqualMatcher {
+    const char *value;
+    int length;
+
+    inline bool operator()(const char *row, int rowLength, bool readable) const {
+        return rowLength == length && stringMismatch(row, value, length, readable) == length;
+    }
+};
+
+struct StringPrefixMatcher {
+    const char *prefix;
+    int length;
+
+    inline bool operator()(const char *row, int rowLength, bool readable) const {
+        return rowLength >= length && stringMismatch(row, prefix, length, readable) == length;
+    }
+};
+
+struct StringBetweenMatcher {
+    const char *lower;
+    int lowerLength;
+    const char *upper;
+    int upperLength;
+
+    inline bool operator()(const char *row, int rowLength, bool readable) const {
+        return stringCompare(row, rowLength, lower, lowerLength, readable) >= 0 &&
+               stringCompare(row, rowLength, upper, upperLength, readable) <= 0;
+    }
+};
+
+// Rows whose vectors of bytes would read past the end of the column are compared a byte at a time
+template<typename Strings, typename Matcher>
+inline bool stringRowMatches(const Strings &strings, long columnBytes, int i, const Matcher &matcher) {
+    long start = stringRowStart(strings, i);
+    int length = stringRowLength(strings, i);
+    return matcher(strings.data + start, length, start + stringBlockBytes(length) <= columnBytes);
+}
+
+// Calls function with the matcher for the predicate, so that the selection loops are compiled for each predicate type
+template<typename Strings, typename Function>
+int withStringMatcher(const Strings &strings, const StringPredicate &predicate, const Function &function) {
+    int paddedLength = stringPaddedLength(strings);
+    switch (predicate.type) {
+        case StringPredicateType::StringEqual: {
+            StringConstant value = stringConstant(predicate.value, paddedLength);
+            return function(StringEqualMatcher{value.bytes.data(), value.length});
+        }
+        case StringPredicateType::StringPrefix: {
+            StringConstant prefix = stringConstant(predicate.value, 0);
+            return function(StringPrefixMatcher{prefix.bytes.data(), prefix.length});
+        }
+        case StringPredicateType::StringBetween: {
+            StringConstant lower = stringConstant(predicate.value, paddedLength);
+            StringConstant upper = stringConstant(predicate.upper, paddedLength);
+            return function(StringBetweenMatcher{lower.bytes.data(), lower.length, upper.bytes.data(), upper.length});
+        }
+        default:
+            std::cout << "Invalid selection of 'StringPredicate' type!" << std::endl;
+            exit(1);
+    }
+}
+
+template<typename Strings, typename Matcher>
+int selectStringIndexesBranchAux(int start, int end, const Strings &inputFilter, long columnBytes,
+                                 const Matcher &matcher, int *selection) {
+    auto k = 0;
+    for (auto i = start; i < end; ++i) {
+        if (stringRowMatches(inputFilter, columnBytes, i, matcher)) {
+            selection[k++] = i;
+        }
+    }
+    return k;
+}
+
+template<typename Strings, typename Matcher>
+int selectStringIndexesPredicationAux(int start, int end, const Strings &inputFilter, long columnBytes,
+                                      const Matcher &matcher, int *selection) {
+    auto k = 0;
+    for (auto i = start; i < end; ++i) {
+        selection[k] = i;
+        k += stringRowMatches(inputFilter, columnBytes, i, matcher);
+    }
+    return k;
+}
+
+template<typename Strings>
+int selectStringIndexesBranch(int n, const Strings &inputFilter, const StringPredicate &predicate, int *selection) {
+    return withStringMatcher(inputFilter, predicate, [&](const auto &matcher) {
+        return selectStringIndexesBranchAux(0, n, inputFilter, stringBytes(inputFilter, n), matcher, selection);
+    });
+}
+
+template<typename Strings>
+int selectStringIndexesPredication(int n, const Strings &inputFilter, const StringPredicate &predicate,
+                                   int *selection) {
+    return withStringMatcher(inputFilter, predicate, [&](const auto &matcher) {
+        return selectStringIndexesPredicationAux(0, n, inputFilter, stringBytes(inputFilter, n), matcher, selection);
+    });
+}
+
+template<typename Strings, typename Matcher>
+inline int runStringSelectChunk(SelectIndexesChoice selectIndexesChoice, int start, int end,
+                                const Strings &inputFilter, long columnBytes, const Matcher &matcher,
+                                int *&selection, int &k, int &consecutivePredications) {
+    int selected;
+    if (selectIndexesChoice == SelectIndexesChoice::IndexesBranch) {
+        Counters::getInstance().readEventSet();
+        selected = selectStringIndexesBranchAux(start, end, inputFilter, columnBytes, matcher, selection);
+        Counters::getInstance().readEventSet();
+    } else {
+        Counters::getInstance().readEventSet();
+        selected = selectStringIndexesPredicationAux(start, end, inputFilter, columnBytes, matcher, selection);
+        Counters::getInstance().readEventSet();
+    }
+    selection += selected;
+    k += selected;
+    consecutivePredications += (selectIndexesChoice == SelectIndexesChoice::IndexesPredication);
+    return selected;
+}
+
+template<typename Strings>
+int selectStringIndexesAdaptive(int n, const Strings &inputFilter, const StringPredicate &predicate, int *selection) {
+    int tuplesPerAdaption = 50000;
+    int maxConsecutivePredications = 10;
+    int tuplesInBranchBurst = 1000;
+
+    // Same cross-over points and branch miss model as selectIndexesAdaptive
+    float lowerCrossoverSelectivity = 0.03;
+    float upperCrossoverSelectivity = 0.98;
+
+    float lowerBranchCrossoverBranchMisses = lowerCrossoverSelectivity * static_cast<float>(tuplesPerAdaption);
+    float upperBranchCrossoverBranchMisses = (1 - upperCrossoverSelectivity) * static_cast<float>(tuplesPerAdaption);
+    float m = (upperBranchCrossoverBranchMisses - lowerBranchCrossoverBranchMisses) /
+              (upperCrossoverSelectivity - lowerCrossoverSelectivity);
+
+    float lowerBranchCrossoverBranchMisses_BranchBurst =
+            lowerCrossoverSelectivity * static_cast<float>(tuplesInBranchBurst);
+    float upperBranchCrossoverBranchMisses_BranchBurst =
+            (1 - upperCrossoverSelectivity) * static_cast<float>(tuplesInBranchBurst);
+    float m_BranchBurst = (upperBranchCrossoverBranchMisses_BranchBurst -
+                           lowerBranchCrossoverBranchMisses_BranchBurst) /
+                          (upperCrossoverSelectivity - lowerCrossoverSelectivity);
+
+    std::vector<std::string> counters = {"PERF_COUNT_HW_BRANCH_MISSES"};
+    long_long *counterValues = Counters::getInstance().getEvents(counters);
+
+    return withStringMatcher(inputFilter, predicate, [&](const auto &matcher) {
+        long columnBytes = stringBytes(inputFilter, n);
+        int k = 0;
+        int consecutivePredications = 0;
+        int tuplesToProcess;
+        int selected;
+        SelectIndexesChoice selectIndexesChoice = SelectIndexesChoice::IndexesPredication;
+
+        for (int start = 0; start < n; start += tuplesToProcess) {
+            if (__builtin_expect(consecutivePredications == maxConsecutivePredications, false)) {
+                selectIndexesChoice = SelectIndexesChoice::IndexesBranch;
+                consecutivePredications = 0;
+                tuplesToProcess = std::min(n - start, tuplesInBranchBurst);
+                selected = runStringSelectChunk(selectIndexesChoice, start, start + tuplesToProcess, inputFilter,
+                                                columnBytes, matcher, selection, k, consecutivePredications);
+                performSelectIndexesAdaption(selectIndexesChoice, counterValues, lowerCrossoverSelectivity,
+                                             upperCrossoverSelectivity,
+                                             lowerBranchCrossoverBranchMisses_BranchBurst, m_BranchBurst,
+                                             static_cast<float>(selected) / static_cast<float>(tuplesInBranchBurst),
+                                             consecutivePredications);
+            } else {
+                tuplesToProcess = std::min(n - start, tuplesPerAdaption);
+                selected = runStringSelectChunk(selectIndexesChoice, start, start + tuplesToProcess, inputFilter,
+                                                columnBytes, matcher, selection, k, consecutivePredications);
+                performSelectIndexesAdaption(selectIndexesChoice, counterValues, lowerCrossoverSelectivity,
+                                             upperCrossoverSelectivity, lowerBranchCrossoverBranchMisses, m,
+                                             static_cast<float>(selected) / static_cast<float>(tuplesPerAdaption),
+                                             consecutivePredications);
+            }
+        }
+        return k;
+    });
+}
+
+template<typename Strings>
+int runStringSelectFunction(StringSelect stringSelectImplementation, int n, const Strings &inputFilter,
+                            const StringPredicate &predicate, int *selection) {
+    switch (stringSelectImplementation) {
+        case StringSelect::StringSelectBranch:
+            return selectStringIndexesBranch(n, inputFilter, predicate, selection);
+        case StringSelect::StringSelectPredication:
+            return selectStringIndexesPredication(n, inputFilter, predicate, selection);
+        case StringSelect::StringSelectAdaptive:
+            return selectStringIndexesAdaptive(n, inputFilter, predicate, selection);
+        default:
+            std::cout << "Invalid selection of 'StringSelect' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
+
+#endif //MABPL_STRINGSELECTIMPLEMENTATION_H
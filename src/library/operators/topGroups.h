@@ -0,0 +1,32 @@
+#ifndef MABPL_TOPGROUPS_H
+#define MABPL_TOPGROUPS_H
+
+#include "groupBy.h"
+
+
+namespace MABPL {
+
+template<typename T1, typename T2>
+struct TopGroupsResult {
+    vectorOfPairs<T1, T2> groups;
+    bool exact;
+};
+
+// The groups with the largest row count or sum of a non-negative aggregate column, largest first, without aggregating
+// every group. A first pass runs weighted space saving in a table whose size depends on the number of groups asked
+// for and the L2 cache, not on the cardinality of the input. It yields an upper and a lower bound on the total of each
+// key it keeps. A second pass totals exactly the keys whose upper bound reaches the lower bound of the groups-th key.
+// The result is exact whenever no key left out of the table could have a larger total than the last group returned,
+// which holds for inputs with heavy hitters. Otherwise exact is false and the groups are the largest exact totals among
+// the candidates.
+template<typename T1>
+TopGroupsResult<T1, long> topGroupsByCount(int n, const T1 *inputGroupBy, int groups);
+
+template<typename T1, typename T2>
+TopGroupsResult<T1, T2> topGroupsBySum(int n, const T1 *inputGroupBy, const T2 *inputAggregate, int groups);
+
+}
+
+#include "topGroupsImplementation.h"
+
+#endif //MABPL_TOPGROUPS_H
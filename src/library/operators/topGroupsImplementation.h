@@ -0,0 +1,205 @@
+#ifndef MABPL_TOPGROUPSIMPLEMENTATION_H
+#define MABPL_TOPGROUPSIMPLEMENTATION_H
+
+#include <algorithm>
+#include <utility>
+#include <functional>
+
+#include "../utilities/systemInformation.h"
+#include "../utilities/memoryArena.h"
+
+
+namespace MABPL {
+
+constexpr int TOPGROUPS_MIN_CANDIDATES_PER_GROUP = 4;
+constexpr float TOPGROUPS_L2_FRACTION = 0.5;
+
+// Space saving counters in a min heap on their totals, so that the smallest is the one replaced by an unseen key. A
+// counter's total is an upper bound on the total of its key and the total minus its error a lower bound.
+template<typename T1, typename T2>
+struct SpaceSavingTable {
+    groupByHashMap<T1, int> slots;
+    T1 *keys;
+    T2 *totals;
+    T2 *errors;
+    int *heap;
+    int *position;
+    int size;
+    int capacity;
+    bool evicted;
+};
+
+template<typename T1, typename T2>
+constexpr int spaceSavingEntryBytes() {
+    return 2 * sizeof(T1) + 2 * sizeof(T2) + 3 * sizeof(int);
+}
+
+template<typename T1, typename T2>
+inline int topGroupsCapacity(int groups) {
+    long l2Bytes = l2cacheSize() > 0 ? l2cacheSize() : 256 * 1024;
+    long budgetEntries = static_cast<long>(TOPGROUPS_L2_FRACTION * l2Bytes) / spaceSavingEntryBytes<T1, T2>();
+    return static_cast<int>(std::max(budgetEntries, static_cast<long>(TOPGROUPS_MIN_CANDIDATES_PER_GROUP) * groups));
+}
+
+template<typename T1, typename T2>
+inline void spaceSavingSwap(SpaceSavingTable<T1, T2> &table, int a, int b) {
+    std::swap(table.heap[a], table.heap[b]);
+    table.position[table.heap[a]] = a;
+    table.position[table.heap[b]] = b;
+}
+
+template<typename T1, typename T2>
+inline void spaceSavingSiftDown(SpaceSavingTable<T1, T2> &table, int index) {
+    while (true) {
+        int smallest = index;
+        int child = 2 * index + 1;
+        if (child < table.size && table.totals[table.heap[child]] < table.totals[table.heap[smallest]]) {
+            smallest = child;
+        }
+        if (child + 1 < table.size && table.totals[table.heap[child + 1]] < table.totals[table.heap[smallest]]) {
+            smallest = child + 1;
+        }
+        if (smallest == index) {
+            return;
+        }
+        spaceSavingSwap(table, index, smallest);
+        index = smallest;
+    }
+}
+
+template<typename T1, typename T2>
+inline void spaceSavingSiftUp(SpaceSavingTable<T1, T2> &table, int index) {
+    while (index > 0 && table.totals[table.heap[index]] < table.totals[table.heap[(index - 1) / 2]]) {
+        spaceSavingSwap(table, index, (index - 1) / 2);
+        index = (index - 1) / 2;
+    }
+}
+
+template<typename T1, typename T2>
+inline void spaceSavingUpdate(SpaceSavingTable<T1, T2> &table, T1 key, T2 weight) {
+    auto it = table.slots.find(key);
+    if (it != table.slots.end()) {
+        int slot = it->second;
+        table.totals[slot] += weight;
+        spaceSavingSiftDown(table, table.position[slot]);
+    } else if (table.size < table.capacity) {
+        int slot = table.size++;
+        table.keys[slot] = key;
+        table.totals[slot] = weight;
+        table.errors[slot] = 0;
+        table.heap[slot] = slot;
+        table.position[slot] = slot;
+        table.slots.insert({key, slot});
+        spaceSavingSiftUp(table, slot);
+    } else {
+        int slot = table.heap[0];
+        table.slots.erase(table.keys[slot]);
+        table.keys[slot] = key;
+        table.errors[slot] = table.totals[slot];
+        table.totals[slot] += weight;
+        table.slots.insert({key, slot});
+        table.evicted = true;
+        spaceSavingSiftDown(table, 0);
+    }
+}
+
+// A run of equal keys updates the table once with the weight of the whole run. Without an aggregate column every row
+// weighs one.
+template<typename T1, typename T2>
+void topGroupsSpaceSavingAux(int n, const T1 *inputGroupBy, const T2 *inputAggregate,
+                             SpaceSavingTable<T1, T2> &table) {
+    int i = 0;
+    while (i < n) {
+        int runLength = keyRunLength(i, n, inputGroupBy);
+        T2 weight = 0;
+        if (inputAggregate == nullptr) {
+            weight = static_cast<T2>(runLength);
+        } else {
+            for (int j = i; j < i + runLength; j++) {
+                weight += inputAggregate[j];
+            }
+        }
+        spaceSavingUpdate(table, inputGroupBy[i], weight);
+        i += runLength;
+    }
+}
+
+template<typename T1, typename T2>
+TopGroupsResult<T1, T2> topGroupsAux(int n, const T1 *inputGroupBy, const T2 *inputAggregate, int groups) {
+    static_assert(isGroupByKeyType<T1>, "GroupBy column must be an integer type");
+    static_assert(std::is_arithmetic<T2>::value, "Payload column must be an numeric type");
+    TopGroupsResult<T1, T2> result{{}, true};
+    if (n == 0 || groups <= 0) {
+        return result;
+    }
+
+    int capacity = topGroupsCapacity<T1, T2>(groups);
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    SpaceSavingTable<T1, T2> table{groupByHashMap<T1, int>(2 * capacity), arena.allocate<T1>(capacity),
+                                   arena.allocate<T2>(capacity), arena.allocate<T2>(capacity),
+                                   arena.allocate<int>(capacity), arena.allocate<int>(capacity), 0, capacity, false};
+    topGroupsSpaceSavingAux(n, inputGroupBy, inputAggregate, table);
+
+    // Without an eviction every key was counted from its first row, so the totals are exact
+    if (!table.evicted) {
+        for (int slot = 0; slot < table.size; slot++) {
+            result.groups.emplace_back(table.keys[slot], table.totals[slot]);
+        }
+    } else {
+        auto *lowerBounds = arena.allocate<T2>(table.size);
+        for (int slot = 0; slot < table.size; slot++) {
+            lowerBounds[slot] = table.totals[slot] - table.errors[slot];
+        }
+        int rank = std::min(groups, table.size) - 1;
+        std::nth_element(lowerBounds, lowerBounds + rank, lowerBounds + table.size, std::greater<T2>());
+        T2 candidateThreshold = lowerBounds[rank];
+
+        groupByHashMap<T1, T2> candidates(2 * capacity);
+        for (int slot = 0; slot < table.size; slot++) {
+            if (table.totals[slot] >= candidateThreshold) {
+                candidates.insert({table.keys[slot], 0});
+            }
+        }
+        for (int i = 0; i < n; i++) {
+            auto it = candidates.find(inputGroupBy[i]);
+            if (it != candidates.end()) {
+                it.value() += inputAggregate == nullptr ? 1 : inputAggregate[i];
+            }
+        }
+        for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+            result.groups.emplace_back(it->first, it->second);
+        }
+    }
+
+    auto byTotal = [](const std::pair<T1, T2> &a, const std::pair<T1, T2> &b) { return a.second > b.second; };
+    if (static_cast<int>(result.groups.size()) > groups) {
+        std::nth_element(result.groups.begin(), result.groups.begin() + groups - 1, result.groups.end(), byTotal);
+        result.groups.resize(groups);
+    }
+    std::sort(result.groups.begin(), result.groups.end(), byTotal);
+
+    // A key left out of the table totals at most the smallest counter
+    if (table.evicted) {
+        T2 smallestCounter = table.totals[table.heap[0]];
+        result.exact = static_cast<int>(result.groups.size()) == groups &&
+                       result.groups.back().second >= smallestCounter;
+    }
+
+    arena.rewind(arenaMark);
+    return result;
+}
+
+template<typename T1>
+TopGroupsResult<T1, long> topGroupsByCount(int n, const T1 *inputGroupBy, int groups) {
+    return topGroupsAux<T1, long>(n, inputGroupBy, nullptr, groups);
+}
+
+template<typename T1, typename T2>
+TopGroupsResult<T1, T2> topGroupsBySum(int n, const T1 *inputGroupBy, const T2 *inputAggregate, int groups) {
+    return topGroupsAux(n, inputGroupBy, inputAggregate, groups);
+}
+
+}
+
+#endif //MABPL_TOPGROUPSIMPLEMENTATION_H
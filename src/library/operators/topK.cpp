@@ -0,0 +1,24 @@
+#include <iostream>
+
+#include "topK.h"
+
+
+namespace MABPL {
+
+std::string getTopKName(TopK topKImplementation) {
+    switch (topKImplementation) {
+        case TopK::TopKHeap:
+            return "TopK_Heap";
+        case TopK::TopKTournament:
+            return "TopK_Tournament";
+        case TopK::TopKNthElement:
+            return "TopK_NthElement";
+        case TopK::TopKAdaptive:
+            return "TopK_Adaptive";
+        default:
+            std::cout << "Invalid selection of 'TopK' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
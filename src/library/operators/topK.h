@@ -0,0 +1,44 @@
+#ifndef MABPL_TOPK_H
+#define MABPL_TOPK_H
+
+#include <string>
+
+
+namespace MABPL {
+
+enum TopK {
+    TopKHeap,
+    TopKTournament,
+    TopKNthElement,
+    TopKAdaptive
+};
+
+std::string getTopKName(TopK topKImplementation);
+
+// ORDER BY key LIMIT k. Writes the min(n, k) rows with the smallest keys, ordered by key, to outputKeys and
+// outputPayloads and returns their number. Rows tying with the k-th key are kept in no particular order. Once k rows
+// have been seen, rows are compared a vector at a time against the largest key kept and only those below it become
+// candidates. topKHeap keeps the k rows in a max heap and topKTournament in a tournament tree, replacing the largest
+// with each candidate. topKNthElement appends candidates to a buffer and cuts it back to k rows with nth_element when
+// it fills. topKAdaptive picks one of the three every chunk from the fraction of rows that became candidates.
+template<typename T1, typename T2>
+int topKHeap(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads);
+
+template<typename T1, typename T2>
+int topKTournament(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads);
+
+template<typename T1, typename T2>
+int topKNthElement(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads);
+
+template<typename T1, typename T2>
+int topKAdaptive(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads);
+
+template<typename T1, typename T2>
+int runTopKFunction(TopK topKImplementation, int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys,
+                    T2 *outputPayloads);
+
+}
+
+#include "topKImplementation.h"
+
+#endif //MABPL_TOPK_H
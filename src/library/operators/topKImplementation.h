@@ -0,0 +1,332 @@
+#ifndef MABPL_TOPKIMPLEMENTATION_H
+#define MABPL_TOPKIMPLEMENTATION_H
+
+#include <iostream>
+#include <algorithm>
+#include <type_traits>
+#include <immintrin.h>
+
+#include "sort.h"
+#include "../utilities/memoryArena.h"
+
+
+namespace MABPL {
+
+constexpr int TOPK_TUPLES_PER_CHUNK = 75 * 1000;
+constexpr int TOPK_CHUNK_K_MULTIPLE = 4;
+constexpr int TOPK_BUFFER_K_MULTIPLE = 4;
+constexpr float TOPK_BUFFER_MIN_CANDIDATE_RATE = 0.01;
+constexpr int TOPK_HEAP_MAX_K = 1024;
+
+// The k rows kept so far, threshold being the largest of their keys. The buffer of topKNthElement extends past the
+// first k entries up to capacity, and the tournament tree holds the index of the largest entry below each node.
+template<typename T1, typename T2>
+struct TopKEntries {
+    SortEntry<T1, T2> *entries;
+    int k;
+    int count;
+    int capacity;
+    int *tree;
+    int treeLeaves;
+    T1 threshold;
+};
+
+// Bit i is set when keys[i] is below the threshold, for a block of eight keys. NaN keys are never below it.
+template<typename T>
+inline unsigned int topKCandidateMask(const T *keys, T threshold) {
+#ifdef __AVX2__
+    if constexpr (std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 4) {
+        __m256i below = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(threshold)),
+                                           _mm256_loadu_si256((const __m256i *)keys));
+        return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(below)));
+    } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 8) {
+        __m256i thresholdVector = _mm256_set1_epi64x(static_cast<long long>(threshold));
+        __m256i belowLow = _mm256_cmpgt_epi64(thresholdVector, _mm256_loadu_si256((const __m256i *)keys));
+        __m256i belowHigh = _mm256_cmpgt_epi64(thresholdVector, _mm256_loadu_si256((const __m256i *)(keys + 4)));
+        return static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(belowLow))) |
+               (static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(belowHigh))) << 4);
+    } else if constexpr (std::is_same<T, float>::value) {
+        __m256 below = _mm256_cmp_ps(_mm256_loadu_ps(keys), _mm256_set1_ps(threshold), _CMP_LT_OQ);
+        return static_cast<unsigned int>(_mm256_movemask_ps(below));
+    } else if constexpr (std::is_same<T, double>::value) {
+        __m256d thresholdVector = _mm256_set1_pd(threshold);
+        __m256d belowLow = _mm256_cmp_pd(_mm256_loadu_pd(keys), thresholdVector, _CMP_LT_OQ);
+        __m256d belowHigh = _mm256_cmp_pd(_mm256_loadu_pd(keys + 4), thresholdVector, _CMP_LT_OQ);
+        return static_cast<unsigned int>(_mm256_movemask_pd(belowLow)) |
+               (static_cast<unsigned int>(_mm256_movemask_pd(belowHigh)) << 4);
+    }
+#endif
+    unsigned int mask = 0;
+    for (int i = 0; i < 8; i++) {
+        mask |= static_cast<unsigned int>(keys[i] < threshold) << i;
+    }
+    return mask;
+}
+
+template<typename T1, typename T2>
+inline bool topKEntryLess(const SortEntry<T1, T2> &a, const SortEntry<T1, T2> &b) {
+    return a.key < b.key;
+}
+
+// Leaves from k up pad the tree to a power of two and lose every match
+template<typename T1, typename T2>
+inline int topKTournamentWinner(const TopKEntries<T1, T2> &topK, int a, int b) {
+    if (b >= topK.k) {
+        return a;
+    }
+    if (a >= topK.k) {
+        return b;
+    }
+    return topK.entries[a].key < topK.entries[b].key ? b : a;
+}
+
+template<typename T1, typename T2>
+void topKBuildTournament(TopKEntries<T1, T2> &topK) {
+    for (int leaf = 0; leaf < topK.treeLeaves; leaf++) {
+        topK.tree[topK.treeLeaves + leaf] = leaf;
+    }
+    for (int node = topK.treeLeaves - 1; node >= 1; node--) {
+        topK.tree[node] = topKTournamentWinner(topK, topK.tree[2 * node], topK.tree[2 * node + 1]);
+    }
+    topK.threshold = topK.entries[topK.tree[1]].key;
+}
+
+template<typename T1, typename T2>
+void topKBuildHeap(TopKEntries<T1, T2> &topK) {
+    std::make_heap(topK.entries, topK.entries + topK.k, topKEntryLess<T1, T2>);
+    topK.threshold = topK.entries[0].key;
+}
+
+// Cuts the buffer back to the k smallest entries, the k-th of which becomes the threshold
+template<typename T1, typename T2>
+void topKCompact(TopKEntries<T1, T2> &topK) {
+    if (topK.count > topK.k) {
+        std::nth_element(topK.entries, topK.entries + topK.k - 1, topK.entries + topK.count,
+                         topKEntryLess<T1, T2>);
+        topK.count = topK.k;
+        topK.threshold = topK.entries[topK.k - 1].key;
+    }
+}
+
+template<TopK topKImplementation, typename T1, typename T2>
+inline void topKInsert(TopKEntries<T1, T2> &topK, T1 key, T2 payload) {
+    if constexpr (topKImplementation == TopK::TopKHeap) {
+        int parent = 0;
+        int child = 1;
+        while (child < topK.k) {
+            child += child + 1 < topK.k && topK.entries[child].key < topK.entries[child + 1].key;
+            if (topK.entries[child].key <= key) {
+                break;
+            }
+            topK.entries[parent] = topK.entries[child];
+            parent = child;
+            child = 2 * child + 1;
+        }
+        topK.entries[parent] = {key, payload};
+        topK.threshold = topK.entries[0].key;
+    } else if constexpr (topKImplementation == TopK::TopKTournament) {
+        int leaf = topK.tree[1];
+        topK.entries[leaf] = {key, payload};
+        for (int node = (topK.treeLeaves + leaf) / 2; node >= 1; node /= 2) {
+            topK.tree[node] = topKTournamentWinner(topK, topK.tree[2 * node], topK.tree[2 * node + 1]);
+        }
+        topK.threshold = topK.entries[topK.tree[1]].key;
+    } else {
+        topK.entries[topK.count++] = {key, payload};
+        if (topK.count == topK.capacity) {
+            topKCompact(topK);
+        }
+    }
+}
+
+// Returns the number of rows that passed the threshold
+template<TopK topKImplementation, typename T1, typename T2>
+int topKScanAux(int start, int end, const T1 *keys, const T2 *payloads, TopKEntries<T1, T2> &topK) {
+    int candidates = 0;
+    int i = start;
+    for (; i + 8 <= end; i += 8) {
+        unsigned int mask = topKCandidateMask(keys + i, topK.threshold);
+        while (mask != 0) {
+            int row = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (keys[row] < topK.threshold) {
+                topKInsert<topKImplementation>(topK, keys[row], payloads[row]);
+                candidates++;
+            }
+        }
+    }
+    for (; i < end; i++) {
+        if (keys[i] < topK.threshold) {
+            topKInsert<topKImplementation>(topK, keys[i], payloads[i]);
+            candidates++;
+        }
+    }
+    return candidates;
+}
+
+// Keeps the first k rows and allocates the buffer and tree that every implementation may switch to
+template<typename T1, typename T2>
+TopKEntries<T1, T2> topKInitialise(const T1 *keys, const T2 *payloads, int k) {
+    MemoryArena &arena = MemoryArena::getInstance();
+    TopKEntries<T1, T2> topK{};
+    topK.k = k;
+    topK.count = k;
+    topK.capacity = TOPK_BUFFER_K_MULTIPLE * k;
+    topK.entries = arena.allocate<SortEntry<T1, T2>>(topK.capacity);
+    topK.treeLeaves = 1;
+    while (topK.treeLeaves < k) {
+        topK.treeLeaves *= 2;
+    }
+    topK.tree = arena.allocate<int>(2 * topK.treeLeaves);
+
+    topK.threshold = keys[0];
+    for (int i = 0; i < k; i++) {
+        topK.entries[i] = {keys[i], payloads[i]};
+        topK.threshold = std::max(topK.threshold, keys[i]);
+    }
+    return topK;
+}
+
+template<typename T1, typename T2>
+int topKOutput(TopKEntries<T1, T2> &topK, T1 *outputKeys, T2 *outputPayloads) {
+    topKCompact(topK);
+    std::sort(topK.entries, topK.entries + topK.k, topKEntryLess<T1, T2>);
+    for (int i = 0; i < topK.k; i++) {
+        outputKeys[i] = topK.entries[i].key;
+        outputPayloads[i] = topK.entries[i].payload;
+    }
+    return topK.k;
+}
+
+template<typename T1, typename T2>
+int topKSmallInput(int n, const T1 *keys, const T2 *payloads, T1 *outputKeys, T2 *outputPayloads) {
+    std::copy(keys, keys + n, outputKeys);
+    std::copy(payloads, payloads + n, outputPayloads);
+    // The radix sorts take integer keys only
+    if constexpr (std::is_integral<T1>::value) {
+        sortAdaptive(n, outputKeys, outputPayloads);
+    } else {
+        sortComparisonAux(0, n, outputKeys, outputPayloads);
+    }
+    return n;
+}
+
+template<TopK topKImplementation, typename T1, typename T2>
+int topKAux(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads) {
+    if (k <= 0) {
+        return 0;
+    }
+    if (n <= k) {
+        return topKSmallInput(n, keys, payloads, outputKeys, outputPayloads);
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    TopKEntries<T1, T2> topK = topKInitialise(keys, payloads, k);
+    if constexpr (topKImplementation == TopK::TopKHeap) {
+        topKBuildHeap(topK);
+    } else if constexpr (topKImplementation == TopK::TopKTournament) {
+        topKBuildTournament(topK);
+    }
+    topKScanAux<topKImplementation>(k, n, keys, payloads, topK);
+    int count = topKOutput(topK, outputKeys, outputPayloads);
+    arena.rewind(arenaMark);
+    return count;
+}
+
+// While many rows pass the threshold it is cheaper to buffer them than to update a heap or tree for each. Once few
+// pass, the heap is kept for small k and the tournament tree, whose replay compares along a fixed path, for large k.
+inline TopK performTopKAdaption(int k, float candidateRate) {
+    if (candidateRate > TOPK_BUFFER_MIN_CANDIDATE_RATE) {
+        return TopK::TopKNthElement;
+    }
+    return k <= TOPK_HEAP_MAX_K ? TopK::TopKHeap : TopK::TopKTournament;
+}
+
+template<typename T1, typename T2>
+int topKHeap(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads) {
+    return topKAux<TopK::TopKHeap>(n, keys, payloads, k, outputKeys, outputPayloads);
+}
+
+template<typename T1, typename T2>
+int topKTournament(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads) {
+    return topKAux<TopK::TopKTournament>(n, keys, payloads, k, outputKeys, outputPayloads);
+}
+
+template<typename T1, typename T2>
+int topKNthElement(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads) {
+    return topKAux<TopK::TopKNthElement>(n, keys, payloads, k, outputKeys, outputPayloads);
+}
+
+// The first chunk buffers, as the threshold of the first k rows passes many. Chunks are long enough that rebuilding
+// the heap or tree on a switch costs little next to scanning them.
+template<typename T1, typename T2>
+int topKAdaptive(int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys, T2 *outputPayloads) {
+    if (k <= 0) {
+        return 0;
+    }
+    if (n <= k) {
+        return topKSmallInput(n, keys, payloads, outputKeys, outputPayloads);
+    }
+
+    MemoryArena &arena = MemoryArena::getInstance();
+    ArenaMark arenaMark = arena.mark();
+    TopKEntries<T1, T2> topK = topKInitialise(keys, payloads, k);
+    TopK implementation = TopK::TopKNthElement;
+    int tuplesPerChunk = std::max(TOPK_TUPLES_PER_CHUNK, TOPK_CHUNK_K_MULTIPLE * k);
+
+    int index = k;
+    while (index < n) {
+        int tuplesToProcess = std::min(tuplesPerChunk, n - index);
+        int candidates;
+        switch (implementation) {
+            case TopK::TopKHeap:
+                candidates = topKScanAux<TopK::TopKHeap>(index, index + tuplesToProcess, keys, payloads, topK);
+                break;
+            case TopK::TopKTournament:
+                candidates = topKScanAux<TopK::TopKTournament>(index, index + tuplesToProcess, keys, payloads, topK);
+                break;
+            default:
+                candidates = topKScanAux<TopK::TopKNthElement>(index, index + tuplesToProcess, keys, payloads, topK);
+        }
+        index += tuplesToProcess;
+
+        TopK nextImplementation = performTopKAdaption(
+                k, static_cast<float>(candidates) / static_cast<float>(tuplesToProcess));
+        if (nextImplementation != implementation) {
+            topKCompact(topK);
+            if (nextImplementation == TopK::TopKHeap) {
+                topKBuildHeap(topK);
+            } else if (nextImplementation == TopK::TopKTournament) {
+                topKBuildTournament(topK);
+            }
+            implementation = nextImplementation;
+        }
+    }
+
+    int count = topKOutput(topK, outputKeys, outputPayloads);
+    arena.rewind(arenaMark);
+    return count;
+}
+
+template<typename T1, typename T2>
+int runTopKFunction(TopK topKImplementation, int n, const T1 *keys, const T2 *payloads, int k, T1 *outputKeys,
+                    T2 *outputPayloads) {
+    switch (topKImplementation) {
+        case TopK::TopKHeap:
+            return topKHeap(n, keys, payloads, k, outputKeys, outputPayloads);
+        case TopK::TopKTournament:
+            return topKTournament(n, keys, payloads, k, outputKeys, outputPayloads);
+        case TopK::TopKNthElement:
+            return topKNthElement(n, keys, payloads, k, outputKeys, outputPayloads);
+        case TopK::TopKAdaptive:
+            return topKAdaptive(n, keys, payloads, k, outputKeys, outputPayloads);
+        default:
+            std::cout << "Invalid selection of 'TopK' implementation!" << std::endl;
+            exit(1);
+    }
+}
+
+}
+
+#endif //MABPL_TOPKIMPLEMENTATION_H
@@ -0,0 +1,116 @@
+#include <immintrin.h>
+#include <cmath>
+
+#include "cardinalityEstimation.h"
+
+namespace MABPL {
+
+HyperLogLog::HyperLogLog(int precision) : precision(precision), registers(1 << precision, 0) {}
+
+void HyperLogLog::addHashes(int n, const uint32_t *hashes) {
+    for (int i = 0; i < n; i++) {
+        uint32_t index = hashes[i] >> (32 - precision);
+        uint32_t remaining = (hashes[i] << precision) | (1u << (precision - 1));
+        auto rank = static_cast<uint8_t>(__builtin_clz(remaining) + 1);
+        registers[index] = std::max(registers[index], rank);
+    }
+}
+
+void HyperLogLog::addHashes(int n, const uint64_t *hashes) {
+    for (int i = 0; i < n; i++) {
+        uint64_t index = hashes[i] >> (64 - precision);
+        uint64_t remaining = (hashes[i] << precision) | (1ull << (precision - 1));
+        auto rank = static_cast<uint8_t>(__builtin_clzll(remaining) + 1);
+        registers[index] = std::max(registers[index], rank);
+    }
+}
+
+double HyperLogLog::estimate() const {
+    double m = registers.size();
+    double sum = 0;
+    int zeroRegisters = 0;
+    for (uint8_t rank : registers) {
+        sum += std::ldexp(1.0, -rank);
+        zeroRegisters += rank == 0;
+    }
+
+    double alpha = 0.7213 / (1 + 1.079 / m);
+    double rawEstimate = alpha * m * m / sum;
+
+    // Linear counting is more accurate while many registers are still empty
+    if (rawEstimate <= 2.5 * m && zeroRegisters > 0) {
+        return m * std::log(m / zeroRegisters);
+    }
+    return rawEstimate;
+}
+
+double HyperLogLog::relativeError() const {
+    return 1.04 / std::sqrt(static_cast<double>(registers.size()));
+}
+
+void hashKeys(int n, const uint32_t *keys, uint32_t *hashes) {
+    int simdWidth = sizeof(__m256i) / sizeof(uint32_t);
+    __m256i firstMultiplier = _mm256_set1_epi32(static_cast<int>(0x85EBCA6Bu));
+    __m256i secondMultiplier = _mm256_set1_epi32(static_cast<int>(0xC2B2AE35u));
+
+    int i = 0;
+    for (; i + simdWidth <= n; i += simdWidth) {
+        __m256i hash = _mm256_loadu_si256((__m256i *)(keys + i));
+        hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+        hash = _mm256_mullo_epi32(hash, firstMultiplier);
+        hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 13));
+        hash = _mm256_mullo_epi32(hash, secondMultiplier);
+        hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+        _mm256_storeu_si256((__m256i *)(hashes + i), hash);
+    }
+
+    for (; i < n; i++) {
+        uint32_t hash = keys[i];
+        hash ^= hash >> 16;
+        hash *= 0x85EBCA6Bu;
+        hash ^= hash >> 13;
+        hash *= 0xC2B2AE35u;
+        hashes[i] = hash ^ (hash >> 16);
+    }
+}
+
+// AVX2 has no 64-bit multiply, so the 64-bit finalizer is left to the compiler
+void hashKeys(int n, const uint64_t *keys, uint64_t *hashes) {
+    for (int i = 0; i < n; i++) {
+        uint64_t hash = keys[i];
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ULL;
+        hashes[i] = hash ^ (hash >> 33);
+    }
+}
+
+double extrapolateCardinality(double sampleDistinct, int sampleSize, int n) {
+    if (sampleSize >= n || sampleDistinct <= 0) {
+        return sampleDistinct;
+    }
+
+    // A sample of s rows over c equally frequent values is expected to hold c * (1 - e^(-s/c)) distinct values,
+    // which increases with c, so c is found by bisection between the sample's distinct count and n
+    auto expectedDistinct = [sampleSize](double cardinality) {
+        return cardinality * (1 - std::exp(-sampleSize / cardinality));
+    };
+    if (expectedDistinct(n) <= sampleDistinct) {
+        return n;
+    }
+
+    double lower = sampleDistinct;
+    double upper = n;
+    for (int i = 0; i < 64; i++) {
+        double middle = (lower + upper) / 2;
+        if (expectedDistinct(middle) < sampleDistinct) {
+            lower = middle;
+        } else {
+            upper = middle;
+        }
+    }
+    return (lower + upper) / 2;
+}
+
+}
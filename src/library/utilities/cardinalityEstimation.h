@@ -0,0 +1,40 @@
+#ifndef MABPL_CARDINALITYESTIMATION_H
+#define MABPL_CARDINALITYESTIMATION_H
+
+#include <cstdint>
+#include <vector>
+
+
+namespace MABPL {
+
+// HyperLogLog sketch, with a relative standard error of roughly 1.04 / sqrt(2^precision). A sketch is fed either 32-bit
+// or 64-bit hashes, never both. 32-bit hashes collide often enough to bias the estimate beyond about 10^8 distinct
+// values, so 64-bit hashes are used where the whole input is counted.
+class HyperLogLog {
+public:
+    explicit HyperLogLog(int precision = 12);
+    void addHashes(int n, const uint32_t *hashes);
+    void addHashes(int n, const uint64_t *hashes);
+    [[nodiscard]] double estimate() const;
+    [[nodiscard]] double relativeError() const;
+
+private:
+    int precision;
+    std::vector<uint8_t> registers;
+};
+
+void hashKeys(int n, const uint32_t *keys, uint32_t *hashes);
+void hashKeys(int n, const uint64_t *keys, uint64_t *hashes);
+
+// Scales the distinct count of a sample up to the full input, assuming every distinct value is equally frequent
+double extrapolateCardinality(double sampleDistinct, int sampleSize, int n);
+
+// Estimates the number of distinct values in input from a HyperLogLog sketch over evenly spaced blocks of the input
+template<typename T>
+int estimateCardinality(int n, const T *input);
+
+}
+
+#include "cardinalityEstimationImplementation.h"
+
+#endif //MABPL_CARDINALITYESTIMATION_H
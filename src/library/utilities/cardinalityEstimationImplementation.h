@@ -0,0 +1,76 @@
+#ifndef MABPL_CARDINALITYESTIMATIONIMPLEMENTATION_H
+#define MABPL_CARDINALITYESTIMATIONIMPLEMENTATION_H
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace MABPL {
+
+constexpr int CARDINALITY_SAMPLE_BLOCK_SIZE = 1024;
+constexpr int CARDINALITY_SAMPLE_BLOCKS = 64;
+constexpr int CARDINALITY_SKETCH_PRECISION = 14;
+
+template<typename T>
+inline uint32_t foldKey(T key) {
+    if constexpr (sizeof(T) <= sizeof(uint32_t)) {
+        return static_cast<uint32_t>(key);
+    } else {
+        uint32_t folded = 0;
+        for (size_t shift = 0; shift < sizeof(T) * 8; shift += 32) {
+            folded = (folded * 0x9E3779B1u) ^ static_cast<uint32_t>(key >> shift);
+        }
+        return folded;
+    }
+}
+
+template<typename T>
+inline uint64_t foldKey64(T key) {
+    if constexpr (sizeof(T) <= sizeof(uint64_t)) {
+        return static_cast<uint64_t>(key);
+    } else {
+        uint64_t folded = 0;
+        for (size_t shift = 0; shift < sizeof(T) * 8; shift += 64) {
+            folded = (folded * 0x9E3779B97F4A7C15ULL) ^ static_cast<uint64_t>(key >> shift);
+        }
+        return folded;
+    }
+}
+
+template<typename T>
+int estimateCardinality(int n, const T *input) {
+    if (n == 0) {
+        return 0;
+    }
+
+    int blocks = std::min(CARDINALITY_SAMPLE_BLOCKS, (n + CARDINALITY_SAMPLE_BLOCK_SIZE - 1) / CARDINALITY_SAMPLE_BLOCK_SIZE);
+    long blockStride = static_cast<long>(n) / blocks;
+
+    uint32_t keys[CARDINALITY_SAMPLE_BLOCK_SIZE];
+    uint32_t hashes[CARDINALITY_SAMPLE_BLOCK_SIZE];
+    HyperLogLog sketch(CARDINALITY_SKETCH_PRECISION);
+    int sampleSize = 0;
+
+    for (int block = 0; block < blocks; block++) {
+        long start = block * blockStride;
+        int blockSize = static_cast<int>(std::min(static_cast<long>(CARDINALITY_SAMPLE_BLOCK_SIZE), n - start));
+        for (int i = 0; i < blockSize; i++) {
+            keys[i] = foldKey(input[start + i]);
+        }
+        hashKeys(blockSize, keys, hashes);
+        sketch.addHashes(blockSize, hashes);
+        sampleSize += blockSize;
+    }
+
+    // A sample that is distinct to within the error of the sketch gives no evidence of repeated values, and under-sizing
+    // a hash table costs more than over-sizing it
+    double sampleDistinct = sketch.estimate();
+    if (sampleDistinct >= sampleSize * (1 - 2 * sketch.relativeError())) {
+        sampleDistinct = sampleSize;
+    }
+    return static_cast<int>(std::lround(extrapolateCardinality(sampleDistinct, sampleSize, n)));
+}
+
+}
+
+#endif //MABPL_CARDINALITYESTIMATIONIMPLEMENTATION_H
@@ -0,0 +1,53 @@
+#include <iostream>
+#include <atomic>
+#include <sys/mman.h>
+
+#include "hugePages.h"
+
+
+namespace MABPL {
+
+static std::atomic<bool> hugeTlbPagesEnabled(false);
+
+// Sizes are rounded the same way on allocation and release so that freeHugePages unmaps exactly what was mapped
+static size_t hugePageMappingBytes(size_t bytes) {
+    size_t pageBytes = bytes >= GIGANTIC_PAGE_BYTES ? GIGANTIC_PAGE_BYTES : HUGE_PAGE_BYTES;
+    return (bytes + pageBytes - 1) & ~(pageBytes - 1);
+}
+
+void useHugeTlbPages(bool enabled) {
+    hugeTlbPagesEnabled = enabled;
+}
+
+void *allocateHugePages(size_t bytes) {
+    size_t size = hugePageMappingBytes(bytes);
+    void *memory = MAP_FAILED;
+
+    if (hugeTlbPagesEnabled) {
+        if (size >= GIGANTIC_PAGE_BYTES) {
+            memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (30 << MAP_HUGE_SHIFT), -1, 0);
+        }
+        if (memory == MAP_FAILED) {
+            memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
+        }
+        if (memory != MAP_FAILED) {
+            return memory;
+        }
+    }
+
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        std::cout << "Failed to map " << size << " bytes!" << std::endl;
+        exit(1);
+    }
+    madvise(memory, size, MADV_HUGEPAGE);
+    return memory;
+}
+
+void freeHugePages(void *memory, size_t bytes) {
+    munmap(memory, hugePageMappingBytes(bytes));
+}
+
+}
@@ -0,0 +1,54 @@
+#ifndef MABPL_HUGEPAGES_H
+#define MABPL_HUGEPAGES_H
+
+#include <cstddef>
+#include <new>
+
+
+namespace MABPL {
+
+constexpr size_t HUGE_PAGE_BYTES = static_cast<size_t>(2) << 20;
+constexpr size_t GIGANTIC_PAGE_BYTES = static_cast<size_t>(1) << 30;
+
+// Large allocations are mapped with transparent huge pages requested through madvise. When hugetlbfs pages are enabled
+// and reserved, they are taken from the hugetlbfs pool instead, with 1 GB pages for allocations of at least 1 GB.
+// Either way an allocation that cannot get huge pages falls back to base pages.
+void useHugeTlbPages(bool enabled);
+void *allocateHugePages(size_t bytes);
+void freeHugePages(void *memory, size_t bytes);
+
+// Standard allocator that takes allocations of at least a huge page from allocateHugePages, used for the storage of
+// group by hash tables
+template<typename T>
+struct HugePageAllocator {
+    using value_type = T;
+
+    HugePageAllocator() = default;
+    template<typename U>
+    HugePageAllocator(const HugePageAllocator<U> &) {}
+
+    T *allocate(size_t count) {
+        if (count * sizeof(T) >= HUGE_PAGE_BYTES) {
+            return static_cast<T *>(allocateHugePages(count * sizeof(T)));
+        }
+        return static_cast<T *>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T *memory, size_t count) {
+        if (count * sizeof(T) >= HUGE_PAGE_BYTES) {
+            freeHugePages(memory, count * sizeof(T));
+        } else {
+            ::operator delete(memory);
+        }
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const HugePageAllocator<T> &, const HugePageAllocator<U> &) { return true; }
+
+template<typename T, typename U>
+bool operator!=(const HugePageAllocator<T> &, const HugePageAllocator<U> &) { return false; }
+
+}
+
+#endif //MABPL_HUGEPAGES_H
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <algorithm>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "memoryArena.h"
+#include "hugePages.h"
+
+
+namespace MABPL {
+
+constexpr size_t ARENA_MINIMUM_BLOCK_BYTES = static_cast<size_t>(64) << 20;
+constexpr int ARENA_MPOL_PREFERRED = 1;
+
+MemoryArena& MemoryArena::getInstance() {
+    static thread_local MemoryArena instance;
+    return instance;
+}
+
+MemoryArena::MemoryArena() {
+    currentBlock = 0;
+    offset = 0;
+}
+
+MemoryArena::~MemoryArena() {
+    for (auto &block : blocks) {
+        freeHugePages(block.memory, block.size);
+    }
+}
+
+ArenaMark MemoryArena::mark() const {
+    return {currentBlock, offset};
+}
+
+void MemoryArena::rewind(ArenaMark arenaMark) {
+    currentBlock = arenaMark.block;
+    offset = arenaMark.offset;
+}
+
+size_t MemoryArena::reservedBytes() const {
+    size_t total = 0;
+    for (auto &block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+void *MemoryArena::allocateBytes(size_t bytes, size_t alignment) {
+    size_t start = (offset + alignment - 1) & ~(alignment - 1);
+    while (currentBlock < blocks.size() && start + bytes > blocks[currentBlock].size) {
+        ++currentBlock;
+        start = 0;
+    }
+    if (currentBlock == blocks.size()) {
+        addBlock(bytes);
+        start = 0;
+    }
+    offset = start + bytes;
+    return blocks[currentBlock].memory + start;
+}
+
+void MemoryArena::addBlock(size_t minimumBytes) {
+    size_t size = std::max(minimumBytes, ARENA_MINIMUM_BLOCK_BYTES);
+    if (!blocks.empty()) {
+        size = std::max(size, 2 * blocks.back().size);
+    }
+    size = (size + HUGE_PAGE_BYTES - 1) & ~(HUGE_PAGE_BYTES - 1);
+
+    void *memory = allocateHugePages(size);
+
+    // Prefer the node of the calling thread, ignored on kernels without NUMA support
+    unsigned int cpu;
+    unsigned int node;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 && node < 8 * sizeof(unsigned long)) {
+        unsigned long nodeMask = 1UL << node;
+        syscall(SYS_mbind, memory, size, ARENA_MPOL_PREFERRED, &nodeMask, 8 * sizeof(unsigned long), 0);
+    }
+
+    long pageSize = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size; i += pageSize) {
+        static_cast<volatile char *>(memory)[i] = 0;
+    }
+
+    blocks.push_back({static_cast<char *>(memory), size});
+}
+
+}
@@ -0,0 +1,53 @@
+#ifndef MABPL_MEMORYARENA_H
+#define MABPL_MEMORYARENA_H
+
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+
+namespace MABPL {
+
+struct ArenaMark {
+    size_t block;
+    size_t offset;
+};
+
+// Bump allocator for operator scratch memory, one per thread. Blocks are backed by huge pages, bound to the NUMA node of
+// the thread that maps them and pre-faulted, then kept when the arena is rewound so that repeated queries reuse resident
+// memory. Allocations are released in LIFO order by rewinding to a mark taken before them.
+class MemoryArena {
+public:
+    static MemoryArena& getInstance();
+    template<typename T>
+    T *allocate(size_t count);
+    [[nodiscard]] ArenaMark mark() const;
+    void rewind(ArenaMark arenaMark);
+    [[nodiscard]] size_t reservedBytes() const;
+    MemoryArena(const MemoryArena&) = delete;
+    void operator=(const MemoryArena&) = delete;
+
+private:
+    struct Block {
+        char *memory;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t currentBlock;
+    size_t offset;
+    void *allocateBytes(size_t bytes, size_t alignment);
+    void addBlock(size_t minimumBytes);
+    MemoryArena();
+    ~MemoryArena();
+};
+
+template<typename T>
+T *MemoryArena::allocate(size_t count) {
+    static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                  "Arena memory is neither constructed nor destroyed");
+    return static_cast<T *>(allocateBytes(count * sizeof(T), alignof(T) > 64 ? alignof(T) : 64));
+}
+
+}
+
+#endif //MABPL_MEMORYARENA_H
@@ -58,7 +58,7 @@ long_long *Counters::addEvents(std::vector<std::string>& counterNames) {
 }
 
 long_long *Counters::eventsAlreadyInSet(std::vector<std::string>& newCounterNames) {
-    for (size_t i = 0; i <= counters.size(); ++i) {
+    for (size_t i = 0; i + newCounterNames.size() <= counters.size(); ++i) {
         if (counters[i] == newCounterNames[0]) {
             bool found = true;
 
@@ -85,6 +85,31 @@ long_long *Counters::getEvents(std::vector<std::string>& counterNames) {
     return addEvents(counterNames);
 }
 
+long_long *Counters::getDTlbMisses() {
+    std::vector<std::string> dTlbCounterNames = {"PAPI_TLB_DM", "perf::DTLB-LOAD-MISSES"};
+    int eventCode;
+
+    for (const std::string& counter : dTlbCounterNames) {
+        std::vector<std::string> counterNames = {counter};
+        long_long *eventValues = eventsAlreadyInSet(counterNames);
+        if (eventValues != nullptr) {
+            return eventValues;
+        }
+    }
+
+    PAPI_stop(eventSet, counterValues);
+    for (const std::string& counter : dTlbCounterNames) {
+        if (PAPI_event_name_to_code(counter.c_str(), &eventCode) == PAPI_OK &&
+            PAPI_add_event(eventSet, eventCode) == PAPI_OK) {
+            counters.push_back(counter);
+            PAPI_start(eventSet);
+            return &(counterValues[counters.size() - 1]);
+        }
+    }
+    PAPI_start(eventSet);
+    return nullptr;
+}
+
 long_long *Counters::readEventSet() {
     for (size_t i = 1; i < counters.size(); ++i) {
         counterValues[i] = 0;
@@ -13,6 +13,9 @@ public:
     static Counters& getInstance();
     long_long *getEvents(std::vector<std::string>& counterNames);
     long_long *readEventSet();
+    // Adds a data TLB miss counter when the processor exposes one, returning nullptr otherwise. After each readEventSet
+    // the returned value holds the misses since the previous read.
+    long_long *getDTlbMisses();
     Counters(const Counters&) = delete;
     void operator=(const Counters&) = delete;
 
@@ -1,6 +1,8 @@
 #include <immintrin.h>
 #include <iostream>
 #include <unistd.h>
+#include <cpuid.h>
+#include <algorithm>
 
 #include "systemInformation.h"
 
@@ -16,6 +18,14 @@ bool arrayIsSimd256Aligned(const int *array) {
     return reinterpret_cast<uintptr_t>(array) % simdAlignment == 0;
 }
 
+long l1cacheSize() {
+    return sysconf(_SC_LEVEL1_DCACHE_SIZE);
+}
+
+long l2cacheSize() {
+    return sysconf(_SC_LEVEL2_CACHE_SIZE);
+}
+
 long l3cacheSize() {
     return sysconf(_SC_LEVEL3_CACHE_SIZE);
 }
@@ -24,4 +34,38 @@ long bytesPerCacheLine() {
     return sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
 }
 
+static long queryDataTlbEntries() {
+    unsigned int eax, ebx, ecx, edx;
+    long entries = 0;
+
+    // Intel deterministic address translation parameters, one subleaf per TLB
+    if (__get_cpuid_count(0x18, 0, &eax, &ebx, &ecx, &edx)) {
+        unsigned int maxSubleaf = eax;
+        for (unsigned int subleaf = 0; subleaf <= maxSubleaf; subleaf++) {
+            __cpuid_count(0x18, subleaf, eax, ebx, ecx, edx);
+            unsigned int type = edx & 0x1F;
+            bool basePages = ebx & 1;
+            if ((type == 1 || type == 3) && basePages) {
+                entries = std::max(entries, static_cast<long>(ebx >> 16) * ecx);
+            }
+        }
+    }
+
+    // AMD second and first level data TLB entries for 4 KB pages, the low bits of 0x80000006 ebx are the L2 ITLB
+    if (entries == 0 && __get_cpuid(0x80000006, &eax, &ebx, &ecx, &edx)) {
+        entries = (ebx >> 16) & 0xFFF;
+    }
+    if (entries == 0 && __get_cpuid(0x80000005, &eax, &ebx, &ecx, &edx)) {
+        entries = (ebx >> 16) & 0xFF;
+    }
+
+    // Virtual machines often hide the TLB leaves, assume the second level TLB size common to x86 cores since Haswell
+    return entries > 0 ? entries : 1024;
+}
+
+long dataTlbEntries() {
+    static const long entries = queryDataTlbEntries();
+    return entries;
+}
+
 }
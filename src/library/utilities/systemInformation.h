@@ -7,8 +7,11 @@ namespace MABPL {
 bool arrayIsSimd128Aligned(const int *array);
 bool arrayIsSimd256Aligned(const int *array);
 
+long l1cacheSize();
+long l2cacheSize();
 long l3cacheSize();
 long bytesPerCacheLine();
+long dataTlbEntries();
 
 }
 
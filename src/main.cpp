@@ -410,7 +410,8 @@ void groupByBenchmarkWithExtraCountersDuringRunConfigurations(const DataFile &da
 
 void allGroupByTests() {
     groupByCpuCyclesSweepBenchmark(DataSweeps::logUniformIntDistribution20mValuesCardinalitySweepFixedMax,
-                                   {GroupBy::Hash, GroupBy::Sort, GroupBy::Adaptive},
+                                   {GroupBy::Hash, GroupBy::Sort, GroupBy::Dense, GroupBy::Hybrid,
+                                    GroupBy::Adaptive},
                                    1, "1-NoClustering");
 
     groupByCpuCyclesSweepBenchmark(DataSweeps::logUniformIntDistribution20mValuesCardinalitySweepFixedMaxClustered10,
@@ -418,7 +419,7 @@ void allGroupByTests() {
                                    1, "1-Clustered10");
 
     groupByCpuCyclesSweepBenchmark(DataSweeps::logUniformIntDistribution20mValuesCardinalitySweepFixedMaxClustered1k,
-                                   {GroupBy::Hash, GroupBy::Sort, GroupBy::Adaptive},
+                                   {GroupBy::Hash, GroupBy::Sort, GroupBy::Hybrid, GroupBy::Adaptive},
                                    1, "1-Clustered1k");
 
     groupByCpuCyclesSweepBenchmark(DataSweeps::logUniformIntDistribution20mValuesCardinalitySweepFixedMaxClustered100k,
@@ -426,7 +427,7 @@ void allGroupByTests() {
                                    1, "1-Clustered100k");
 
     groupByCpuCyclesSweepBenchmark(DataSweeps::logUniformIntDistribution20mValuesCardinalitySweepVariableMax,
-                                   {GroupBy::Hash, GroupBy::Sort, GroupBy::Adaptive},
+                                   {GroupBy::Hash, GroupBy::Sort, GroupBy::Dense, GroupBy::Adaptive},
                                    1, "1-NoClustering-VariableUpperBound");
 
     groupByCpuCyclesSweepBenchmark64(DataSweeps::logUniformInt64Distribution20mValuesCardinalitySweepFixedMax,
@@ -458,6 +459,11 @@ void allGroupByTests() {
                                    1, "3-MultipleSection_10m_100");
 }
 
+void groupByAdaptiveCalibration() {
+    groupByAdaptiveCalibrationBenchmark(DataSweeps::logUniformIntDistribution20mValuesCardinalitySweepFixedMax, 3,
+                                        "Calibration");
+}
+
 int main() {
 
     tessilRobinMapInitialisationBenchmark("MapInitialisationCostNoWrites");